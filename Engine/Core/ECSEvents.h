@@ -12,7 +12,7 @@
 \brief
 Defines ECS lifecycle event types related to entity and component changes.
 
-This file contains event classes for entity creation and destruction, as well as component
+This file contains event classes for entity creation and destruction (single and batched), as well as component
 addition and removal within the ECS framework. Each event carries essential data such as
 entity identifiers and component type information, with priority levels assigned to guide
 their processing order in the event system.
@@ -38,6 +38,17 @@ namespace Uma_Engine
         int entityCnt;
     };
 
+    // summary of a batch created through Coordinator::CreateEntities / Instantiate, sent once instead of per entity
+    class EntitiesCreatedEvent : public Event
+    {
+    public:
+        EntitiesCreatedEvent(int createdCnt, int entityCnt) : createdCnt(createdCnt), entityCnt(entityCnt) { priority = Priority::Normal; }
+
+    public:
+        int createdCnt;
+        int entityCnt;
+    };
+
     class EntityDestroyedEvent : public Event
     {
     public:
@@ -48,6 +59,17 @@ namespace Uma_Engine
         int entityCnt;
     };
 
+    // summary of a batch of destroyed entities, sent once instead of per entity
+    class EntitiesDestroyedEvent : public Event
+    {
+    public:
+        EntitiesDestroyedEvent(int destroyedCnt, int entityCnt) : destroyedCnt(destroyedCnt), entityCnt(entityCnt) { priority = Priority::High; }
+
+    public:
+        int destroyedCnt;
+        int entityCnt;
+    };
+
     class ComponentAddedEvent : public Event
     {
     public:
@@ -51,6 +51,12 @@ namespace Uma_Engine
 			StressTestRequestEvent(){ priority = Priority::High; }
 	};
 
+	class ECSBenchmarkRequestEvent : public Event
+	{
+	public:
+			ECSBenchmarkRequestEvent() { priority = Priority::Normal; }
+	};
+
 	class ShowEntityInVPRequestEvent : public Event
 	{
 	public:
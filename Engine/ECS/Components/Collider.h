@@ -16,6 +16,10 @@ Uses bitmask enums (CollisionLayer) for efficient collision layer management sup
 Stores min/max bounds for broadphase tests and layer/colliderMask bitmasks for filtering which layers can interact.
 Includes predefined layers: DEFAULT, PLAYER, ENEMY, WALL, PROJECTILE, PICKUP with CL_ALL wildcard.
 Provides JSON serialization for bounding box coordinates and layer masks. BoundingBox struct stores Vec2 min/max extents.
+Collider is split hot / cold. Collider keeps the authoring data (shape list, default layers, showBBox) for the editor and
+serialization, ColliderHot is the fixed size runtime half packed in the Collider pool: the first INLINE_COLLIDER_SHAPES
+shapes with their effective layer / mask, purpose and the world bounds CollisionSystem rebuilds, so the broad and narrow
+phase never follow the shape vector. The rare extra shapes, up to MAX_COLLIDER_SHAPES, keep theirs in Collider::overflow.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -25,6 +29,14 @@ All rights reserved.
 
 #include "Math/Math.h"
 #include "Core/Types.hpp"
+#include "Debugging/Debugger.hpp"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
 
 namespace Uma_ECS
 {
@@ -50,7 +62,8 @@ namespace Uma_ECS
         Vec2 max{};
     };
 
-    enum class ColliderPurpose
+    // one byte, it is packed per shape in ColliderHot
+    enum class ColliderPurpose : uint8_t
     {
         Physics = 0,      // Entity-to-entity (damage, interaction)
         Environment = 1,  // Entity-to-wall (movement blocking)
@@ -68,17 +81,37 @@ namespace Uma_ECS
         bool autoFitToSprite = false;  // Add this per-shape flag
     };
 
+    // shapes a collider can have at runtime, one bit each in ColliderHot's activeBits / autoFitBits
+    const size_t MAX_COLLIDER_SHAPES = 8;
+
+    // shapes kept in the packed ColliderHot record, walls use one and enemies two (body + feet)
+    const size_t INLINE_COLLIDER_SHAPES = 2;
+
+    // runtime data of one shape
+    struct ColliderShapeHot
+    {
+        // world space, rebuilt by CollisionSystem::UpdateBoundingBoxes
+        BoundingBox bounds{};
+
+        Vec2 size{};
+        Vec2 offset{};
+        LayerMask layer = CL_NONE;  // effective layer
+        LayerMask mask = CL_NONE;   // effective collider mask
+        ColliderPurpose purpose = ColliderPurpose::Physics;
+    };
+
+    // authoring half, the runtime bounds live in ColliderHot
     struct Collider
     {
         std::vector<ColliderShape> shapes;
 
+        // runtime data of the shapes past INLINE_COLLIDER_SHAPES, rebuilt with their bounds, never serialized
+        std::vector<ColliderShapeHot> overflow;
+
         LayerMask defaultLayer = CL_DEFAULT;
         LayerMask defaultMask = CL_ALL;
         bool showBBox = false;
 
-        // Runtime data
-        std::vector<BoundingBox> bounds;
-
         // Constructor with default shape
         Collider()
         {
@@ -88,7 +121,6 @@ namespace Uma_ECS
                 .purpose = ColliderPurpose::Physics,
                 .autoFitToSprite = true  // Primary shape auto-fits by default
                 });
-            bounds.resize(1);
         }
 
         inline LayerMask GetEffectiveLayer(size_t index) const
@@ -107,9 +139,6 @@ namespace Uma_ECS
         inline ColliderShape& GetPrimaryShape() { return shapes[0]; }
         inline const ColliderShape& GetPrimaryShape() const { return shapes[0]; }
 
-        inline BoundingBox& GetPrimaryBounds() { return bounds[0]; }
-        inline const BoundingBox& GetPrimaryBounds() const { return bounds[0]; }
-
         // Serialize/Deserialize updated below
         void Serialize(rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) const
         {
@@ -164,6 +193,13 @@ namespace Uma_ECS
 
                 for (const auto& shapeVal : shapesArray.GetArray())
                 {
+                    if (shapes.size() == MAX_COLLIDER_SHAPES)
+                    {
+                        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, "Collider has " + std::to_string(shapesArray.Size())
+                            + " shapes, only the first " + std::to_string(MAX_COLLIDER_SHAPES) + " (MAX_COLLIDER_SHAPES) are loaded.");
+                        break;
+                    }
+
                     ColliderShape shape;
 
                     if (shapeVal.HasMember("offset"))
@@ -202,8 +238,83 @@ namespace Uma_ECS
                 {
                     shapes.push_back(ColliderShape{ .autoFitToSprite = true });
                 }
+            }
+        }
+    };
+
+
+    // runtime half of Collider, packed in the Collider pool next to the components
+    // sized for the common collider, shape i is used when bit i of activeBits is set
+    struct ColliderHot
+    {
+        std::array<ColliderShapeHot, INLINE_COLLIDER_SHAPES> shapes{};
+
+        uint8_t count = 0; // every shape, the ones past INLINE_COLLIDER_SHAPES are in Collider::overflow
+        uint8_t activeBits = 0;
+        uint8_t autoFitBits = 0;
+        bool showBBox = false;
+
+        inline bool IsActive(size_t index) const { return (activeBits >> index) & 1u; }
+        inline bool AutoFits(size_t index) const { return (autoFitBits >> index) & 1u; }
+        inline bool HasOverflow() const { return count > INLINE_COLLIDER_SHAPES; }
+
+        // shape index, pCold is the authoring half of the same collider, only read when HasOverflow
+        inline const ColliderShapeHot& GetShape(size_t index, const Collider* pCold) const
+        {
+            return index < INLINE_COLLIDER_SHAPES ? shapes[index] : pCold->overflow[index - INLINE_COLLIDER_SHAPES];
+        }
+
+        inline ColliderShapeHot& GetShape(size_t index, Collider* pCold)
+        {
+            return index < INLINE_COLLIDER_SHAPES ? shapes[index] : pCold->overflow[index - INLINE_COLLIDER_SHAPES];
+        }
+    };
+    static_assert(MAX_COLLIDER_SHAPES <= 8, "Error : ColliderHot keeps one bit per shape in a uint8_t.");
+
+    template<>
+    struct HotData<Collider>
+    {
+        using type = ColliderHot;
+
+        // called when a collider enters the pool, the shapes past the cap would never collide
+        static void Validate(const Collider& collider)
+        {
+            if (collider.shapes.size() <= MAX_COLLIDER_SHAPES) return;
+
+            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, "Collider added with " + std::to_string(collider.shapes.size())
+                + " shapes, only the first " + std::to_string(MAX_COLLIDER_SHAPES) + " (MAX_COLLIDER_SHAPES) collide.");
+            assert(false && "Error : Collider has more shapes than MAX_COLLIDER_SHAPES.");
+        }
+
+        // refreshes one shape's data from the authoring half, the bounds are runtime only and left as they are
+        static void SyncShape(const Collider& collider, size_t index, ColliderShapeHot& hot)
+        {
+            const ColliderShape& shape = collider.shapes[index];
+
+            hot.size = shape.size;
+            hot.offset = shape.offset;
+            hot.layer = collider.GetEffectiveLayer(index);
+            hot.mask = collider.GetEffectiveMask(index);
+            hot.purpose = shape.purpose;
+        }
+
+        // a changed collider gets its bounds rebuilt, and its overflow shapes with them
+        // a collider over the cap was reported by Validate, its first MAX_COLLIDER_SHAPES shapes are kept
+        static void Sync(const Collider& collider, ColliderHot& hot)
+        {
+            hot.count = static_cast<uint8_t>(std::min(collider.shapes.size(), MAX_COLLIDER_SHAPES));
+            hot.activeBits = 0;
+            hot.autoFitBits = 0;
+            hot.showBBox = collider.showBBox;
+
+            for (size_t i = 0; i < hot.count; ++i)
+            {
+                const ColliderShape& shape = collider.shapes[i];
+
+                if (i < INLINE_COLLIDER_SHAPES) SyncShape(collider, i, hot.shapes[i]);
 
-                bounds.resize(shapes.size());
+                if (shape.isActive) hot.activeBits |= static_cast<uint8_t>(1u << i);
+                if (shape.autoFitToSprite) hot.autoFitBits |= static_cast<uint8_t>(1u << i);
             }
         }
     };
@@ -12,10 +12,14 @@
 \brief
 Defines sprite rendering component that references texture assets by name with flip flags for mirroring.
 
-Stores texture name string for serialization and cached Texture pointer (managed by ResourcesManager) for runtime rendering.
+Sprite is split hot / cold. Sprite itself is the authoring half (texture name, layer, flip flags) used by the editor
+and serialization. SpriteHot is the packed runtime half RenderingSystem streams every frame: the cached Texture pointer
+(managed by ResourcesManager) and a copy of the layer and flags, refreshed through HotData<Sprite>::Sync.
 Supports horizontal and vertical sprite flipping through flipX/flipY boolean flags.
+Sprite can also be used as a shared component (Shared<Sprite>), entities with an equal Sprite share one copy and one
+resolved texture.
 Serializes only texture name (not pointer) to JSON for persistent storage. Texture pointer is resolved at runtime
-by RenderingSystem through ResourcesManager lookup. Used by RenderingSystem for batched sprite drawing.
+by RenderingSystem through ResourcesManager lookup, again whenever the texture name changes.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -27,6 +31,10 @@ All rights reserved.
 #include "../Systems/ResourcesTypes.hpp"
 #include "Core/Types.hpp"
 
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
 namespace Uma_ECS
 {
     enum RenderLayer : LayerMask
@@ -41,15 +49,18 @@ namespace Uma_ECS
 
 
     // currently in 2d
+    // authoring half, the texture is resolved into SpriteHot
     struct Sprite
     {
-        // pointer pointing to the texture in resources manager
+        // name of the texture in resources manager
         std::string textureName{};
         LayerMask renderLayer = RL_NONE;
         bool flipX{};
         bool flipY{};
         bool UseNativeSize{};
-        Uma_Engine::Texture* texture = nullptr;
+
+        // shared sprites are grouped by value
+        bool operator==(const Sprite&) const = default;
 
         void Serialize(rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) const //override
         {
@@ -82,4 +93,46 @@ namespace Uma_ECS
             UseNativeSize = value["Native"].GetBool();
         }
     };
+
+    // one id per distinct texture name, so the hot half can tell names apart without keeping a string
+    inline uint32_t GetTextureNameId(const std::string& textureName)
+    {
+        static std::unordered_map<std::string, uint32_t> ids;
+        return ids.try_emplace(textureName, static_cast<uint32_t>(ids.size() + 1)).first->second;
+    }
+
+    // runtime half of Sprite, packed in the Sprite pool next to the components
+    struct SpriteHot
+    {
+        // pointer pointing to the texture in resources manager, nullptr until RenderingSystem resolves it
+        Uma_Engine::Texture* texture = nullptr;
+        // GetTextureNameId of the textureName the texture belongs to, a new name drops the texture
+        uint32_t textureNameId = 0;
+
+        LayerMask renderLayer = RL_NONE;
+        bool flipX{};
+        bool flipY{};
+        bool UseNativeSize{};
+    };
+
+    template<>
+    struct HotData<Sprite>
+    {
+        using type = SpriteHot;
+
+        static void Sync(const Sprite& sprite, SpriteHot& hot)
+        {
+            uint32_t textureNameId = GetTextureNameId(sprite.textureName);
+            if (textureNameId != hot.textureNameId)
+            {
+                hot.texture = nullptr;
+                hot.textureNameId = textureNameId;
+            }
+
+            hot.renderLayer = sprite.renderLayer;
+            hot.flipX = sprite.flipX;
+            hot.flipY = sprite.flipY;
+            hot.UseNativeSize = sprite.UseNativeSize;
+        }
+    };
 }
\ No newline at end of file
@@ -12,9 +12,11 @@
 \brief
 Defines spatial transformation component for 2D entity positioning, rotation, and scaling.
 
-Contains position, rotation (x=angle, y=angular velocity), scale as Vec2 values, and prevPos for swept collision detection.
-prevPos is automatically set during deserialization and updated by PhysicsSystem for temporal coherence in collision queries.
-Provides JSON serialization for position, rotation, and scale only (prevPos excluded as runtime-only data).
+Contains position, rotation (x=angle, y=angular velocity), scale as Vec2 values.
+Transform is DoubleBuffered, its pool keeps the state published at the end of the last frame, which replaces the old
+prevPos field: ComponentArray<Transform>::GetPrevious is the interpolation / swept collision source and the state
+read-only consumers (rendering, AI) read while PhysicsSystem writes the next one.
+Provides JSON serialization for position, rotation, and scale.
 Core component used by nearly all systems for spatial queries and world-space transformations.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
@@ -24,6 +26,7 @@ All rights reserved.
 #pragma once
 
 #include "../../Math/Math.h"
+#include "Core/Types.hpp"
 //#include "Core/SerializationBase.h"
 
 namespace Uma_ECS
@@ -34,7 +37,6 @@ namespace Uma_ECS
         Vec2 position{};
         Vec2 rotation{};
         Vec2 scale{};
-        Vec2 prevPos{}; // shdnt edit this value manually
 
         void Serialize(rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) const //override
         {
@@ -57,8 +59,6 @@ namespace Uma_ECS
             scl.AddMember("x", scale.x, allocator);
             scl.AddMember("y", scale.y, allocator);
             value.AddMember("scale", scl, allocator);
-
-            // prev pos is runtime object no need to save
         }
 
         // Deserialize from JSON
@@ -75,9 +75,13 @@ namespace Uma_ECS
             const auto& scl = value["scale"];
             scale.x = scl["x"].GetFloat();
             scale.y = scl["y"].GetFloat();
-
-            // Reset prevPos automatically
-            prevPos = position;
         }
     };
+
+    // previous frame's transform kept by the pool, see ComponentArray::GetPrevious
+    template<>
+    struct DoubleBuffered<Transform>
+    {
+        static constexpr bool value = true;
+    };
 }
\ No newline at end of file
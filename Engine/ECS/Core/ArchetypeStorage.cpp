@@ -0,0 +1,341 @@
+/*!
+\file   ArchetypeStorage.cpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements chunk allocation, row management and archetype transitions for the archetype storage backend.
+
+Chunk layout and rows per chunk are computed once per archetype from the registered column sizes and alignments.
+Rows are kept packed (only the last chunk can be partially filled) by moving the last row into removed rows.
+Entity records map each entity to its archetype and row so component lookups stay O(1).
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#include "ArchetypeStorage.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    inline size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+namespace Uma_ECS
+{
+    Archetype::Archetype(const Signature& signature, const std::vector<ComponentColumnInfo>& columnInfos)
+        : mSignature(signature)
+    {
+        aAddEdges.fill(INVALID_ARCHETYPE);
+        aRemoveEdges.fill(INVALID_ARCHETYPE);
+
+        size_t rowBytes = sizeof(Entity);
+        signature.ForEachSetBit([&](size_t bit)
+            {
+                ComponentType type = static_cast<ComponentType>(bit);
+
+                assert(type < columnInfos.size() && columnInfos[type].registered && "Error : Component is not registered before.");
+
+                aTypes.push_back(type);
+                aColumnInfos[type] = columnInfos[type];
+
+                rowBytes += columnInfos[type].size;
+                mChunkAlignment = std::max(mChunkAlignment, columnInfos[type].alignment);
+            });
+
+        // computes the column offsets for a given capacity, returns the total bytes needed
+        auto layout = [this](size_t capacity)
+            {
+                size_t offset = sizeof(Entity) * capacity;
+                for (ComponentType type : aTypes)
+                {
+                    offset = AlignUp(offset, aColumnInfos[type].alignment);
+                    aColumnOffsets[type] = offset;
+                    offset += aColumnInfos[type].size * capacity;
+                }
+                return offset;
+            };
+
+        // fit as many rows as possible in a chunk, padding between columns can push it over so shrink till it fits
+        mChunkCapacity = std::max<size_t>(1, ARCHETYPE_CHUNK_SIZE / rowBytes);
+        while (mChunkCapacity > 1 && layout(mChunkCapacity) > ARCHETYPE_CHUNK_SIZE)
+        {
+            --mChunkCapacity;
+        }
+
+        // a single row bigger than a chunk gets a chunk of its own size
+        mChunkBytes = std::max(ARCHETYPE_CHUNK_SIZE, AlignUp(layout(mChunkCapacity), mChunkAlignment));
+    }
+
+    Archetype::~Archetype()
+    {
+        // destroy the remaining components before releasing the chunks
+        while (mSize > 0)
+        {
+            RemoveRow(mSize - 1);
+        }
+
+        for (auto& chunk : aChunks)
+        {
+            ::operator delete(chunk.pMemory, std::align_val_t{ mChunkAlignment });
+        }
+    }
+
+    void Archetype::AllocateChunk()
+    {
+        ArchetypeChunk chunk;
+        chunk.pMemory = static_cast<std::byte*>(::operator new(mChunkBytes, std::align_val_t{ mChunkAlignment }));
+        chunk.count = 0;
+        aChunks.push_back(chunk);
+    }
+
+    size_t Archetype::PushRow(Entity entity)
+    {
+        if (mSize == aChunks.size() * mChunkCapacity)
+        {
+            AllocateChunk();
+        }
+
+        size_t row = mSize;
+        ArchetypeChunk& chunk = aChunks[row / mChunkCapacity];
+
+        GetEntityColumn(chunk)[row % mChunkCapacity] = entity;
+        ++chunk.count;
+        ++mSize;
+
+        return row;
+    }
+
+    Entity Archetype::RemoveRow(size_t row)
+    {
+        assert(row < mSize && "Error : Archetype row out of range.");
+
+        size_t last = mSize - 1;
+        Entity moved = INVALID_ENTITY;
+
+        for (ComponentType type : aTypes)
+        {
+            void* dst = GetComponentPtr(type, row);
+            aColumnInfos[type].Destroy(dst);
+
+            // swap and pop, move the last row into the hole
+            if (row != last)
+            {
+                void* src = GetComponentPtr(type, last);
+                aColumnInfos[type].MoveConstruct(dst, src);
+                aColumnInfos[type].Destroy(src);
+            }
+        }
+
+        if (row != last)
+        {
+            moved = GetEntity(last);
+            GetEntityColumn(aChunks[row / mChunkCapacity])[row % mChunkCapacity] = moved;
+        }
+
+        ArchetypeChunk& lastChunk = aChunks[last / mChunkCapacity];
+        --lastChunk.count;
+        --mSize;
+
+        // release the trailing chunk once it is empty
+        if (lastChunk.count == 0)
+        {
+            ::operator delete(lastChunk.pMemory, std::align_val_t{ mChunkAlignment });
+            aChunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    ArchetypeStorage::ArchetypeStorage()
+    {
+        // archetype 0 is always the empty archetype, every new entity starts here
+        GetOrCreateArchetype(Signature{});
+    }
+
+    void ArchetypeStorage::CreateEntity(Entity entity)
+    {
+        if (aRecords.size() <= entity)
+        {
+            aRecords.resize(static_cast<size_t>(entity) + 1);
+        }
+
+        assert(aRecords[entity].archetype == INVALID_ARCHETYPE && "Error : Entity already exists in the archetype storage.");
+
+        aRecords[entity].archetype = 0;
+        aRecords[entity].row = aArchetypes[0]->PushRow(entity);
+    }
+
+    void ArchetypeStorage::DestroyEntity(Entity entity)
+    {
+        if (entity >= aRecords.size() || aRecords[entity].archetype == INVALID_ARCHETYPE) return;
+
+        EntityRecord& record = aRecords[entity];
+        Entity moved = aArchetypes[record.archetype]->RemoveRow(record.row);
+
+        if (moved != INVALID_ENTITY)
+        {
+            aRecords[moved].row = record.row;
+        }
+
+        record = EntityRecord{};
+    }
+
+    void ArchetypeStorage::CloneEntity(Entity src, Entity dest)
+    {
+        assert(src < aRecords.size() && aRecords[src].archetype != INVALID_ARCHETYPE && "Error : src entity doesn't exist.");
+
+        // dest is moved straight into the archetype of src, then every column is copy constructed
+        size_t archetypeIndex = aRecords[src].archetype;
+        size_t row = MoveEntity(dest, archetypeIndex);
+
+        Archetype& archetype = *aArchetypes[archetypeIndex];
+        size_t srcRow = aRecords[src].row;
+
+        for (ComponentType type : archetype.GetTypes())
+        {
+            aColumnInfos[type].CopyConstruct(archetype.GetComponentPtr(type, row), archetype.GetComponentPtr(type, srcRow));
+        }
+    }
+
+    void ArchetypeStorage::CreateEntities(const std::vector<Entity>& entities, const Signature& signature)
+    {
+        if (entities.empty()) return;
+
+        Entity maxEntity = *std::max_element(entities.begin(), entities.end());
+        if (aRecords.size() <= maxEntity)
+        {
+            aRecords.resize(static_cast<size_t>(maxEntity) + 1);
+        }
+
+        // no detour through the empty archetype, every column is default constructed in place
+        size_t archetypeIndex = GetOrCreateArchetype(signature);
+        Archetype& archetype = *aArchetypes[archetypeIndex];
+
+        for (Entity entity : entities)
+        {
+            assert(aRecords[entity].archetype == INVALID_ARCHETYPE && "Error : Entity already exists in the archetype storage.");
+
+            size_t row = archetype.PushRow(entity);
+            aRecords[entity] = EntityRecord{ archetypeIndex, row };
+
+            for (ComponentType type : archetype.GetTypes())
+            {
+                aColumnInfos[type].DefaultConstruct(archetype.GetComponentPtr(type, row));
+            }
+        }
+    }
+
+    void ArchetypeStorage::CloneEntity(Entity src, const std::vector<Entity>& dests)
+    {
+        assert(src < aRecords.size() && aRecords[src].archetype != INVALID_ARCHETYPE && "Error : src entity doesn't exist.");
+
+        if (dests.empty()) return;
+
+        Entity maxEntity = *std::max_element(dests.begin(), dests.end());
+        if (aRecords.size() <= maxEntity)
+        {
+            aRecords.resize(static_cast<size_t>(maxEntity) + 1);
+        }
+
+        size_t archetypeIndex = aRecords[src].archetype;
+        Archetype& archetype = *aArchetypes[archetypeIndex];
+
+        // rows are only appended below, the row of src doesn't move
+        size_t srcRow = aRecords[src].row;
+
+        for (Entity dest : dests)
+        {
+            assert(aRecords[dest].archetype == INVALID_ARCHETYPE && "Error : Entity already exists in the archetype storage.");
+
+            size_t row = archetype.PushRow(dest);
+            aRecords[dest] = EntityRecord{ archetypeIndex, row };
+
+            for (ComponentType type : archetype.GetTypes())
+            {
+                const ComponentColumnInfo& info = aColumnInfos[type];
+                void* dst = archetype.GetComponentPtr(type, row);
+                void* from = archetype.GetComponentPtr(type, srcRow);
+
+                if (info.trivial)
+                {
+                    std::memcpy(dst, from, info.size);
+                }
+                else
+                {
+                    info.CopyConstruct(dst, from);
+                }
+            }
+        }
+    }
+
+    void ArchetypeStorage::Clear()
+    {
+        aArchetypes.clear();
+        aArchetypeLookup.clear();
+        aRecords.clear();
+
+        GetOrCreateArchetype(Signature{});
+    }
+
+    size_t ArchetypeStorage::GetOrCreateArchetype(const Signature& signature)
+    {
+        auto it = aArchetypeLookup.find(signature);
+        if (it != aArchetypeLookup.end())
+        {
+            return it->second;
+        }
+
+        size_t index = aArchetypes.size();
+        aArchetypes.push_back(std::make_unique<Archetype>(signature, aColumnInfos));
+        aArchetypeLookup.insert({ signature, index });
+
+        return index;
+    }
+
+    size_t ArchetypeStorage::MoveEntity(Entity entity, size_t dst)
+    {
+        EntityRecord& record = aRecords[entity];
+
+        if (record.archetype == dst) return record.row;
+
+        Archetype& to = *aArchetypes[dst];
+        size_t newRow = to.PushRow(entity);
+
+        if (record.archetype != INVALID_ARCHETYPE)
+        {
+            Archetype& from = *aArchetypes[record.archetype];
+
+            // move the columns both archetypes share, the rest is destroyed with the old row
+            for (ComponentType type : from.GetTypes())
+            {
+                if (!to.GetSignature().test(type)) continue;
+
+                aColumnInfos[type].MoveConstruct(to.GetComponentPtr(type, newRow), from.GetComponentPtr(type, record.row));
+            }
+
+            Entity moved = from.RemoveRow(record.row);
+            if (moved != INVALID_ENTITY)
+            {
+                aRecords[moved].row = record.row;
+            }
+        }
+
+        record.archetype = dst;
+        record.row = newRow;
+
+        return newRow;
+    }
+}
@@ -0,0 +1,306 @@
+/*!
+\file   ArchetypeStorage.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements the optional archetype (chunk based) component storage backend for the Coordinator.
+
+Entities sharing the same Signature are grouped into an Archetype made of fixed-size chunks (ARCHETYPE_CHUNK_SIZE).
+Each chunk stores the entity ids followed by one column per component type, so a multi-component iteration
+is a linear walk over contiguous memory instead of a lookup into one ComponentArray per type.
+Adding or removing a component moves the entity to the neighbouring archetype, the transitions are cached as
+graph edges on the archetype. Component columns are type erased through ComponentColumnInfo function pointers,
+which allows non trivial components (std::vector / std::string members) to be moved between chunks safely.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <new>
+#include <cstddef>
+#include <cassert>
+
+namespace Uma_ECS
+{
+    // size of one archetype chunk in bytes, rows per chunk are derived from the archetype row size
+    const size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+    // archetype index used when an entity is not stored in any archetype
+    const size_t INVALID_ARCHETYPE = static_cast<size_t>(-1);
+
+    // type erased operations for one component column
+    struct ComponentColumnInfo
+    {
+        size_t size = 0;
+        size_t alignment = 0;
+
+        void (*DefaultConstruct)(void* dst) = nullptr;
+        void (*MoveConstruct)(void* dst, void* src) = nullptr;
+        void (*CopyConstruct)(void* dst, const void* src) = nullptr;
+        void (*Destroy)(void* ptr) = nullptr;
+
+        bool trivial = false;       // trivially copyable, copies can be a memcpy
+        bool registered = false;
+
+        template<typename T>
+        static ComponentColumnInfo Create()
+        {
+            ComponentColumnInfo info;
+            info.size = sizeof(T);
+            info.alignment = alignof(T);
+            info.DefaultConstruct = [](void* dst) { new (dst) T{}; };
+            info.MoveConstruct = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); };
+            info.CopyConstruct = [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); };
+            info.Destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+            info.trivial = std::is_trivially_copyable_v<T>;
+            info.registered = true;
+            return info;
+        }
+    };
+
+    struct ArchetypeChunk
+    {
+        std::byte* pMemory = nullptr;   // entity ids first, then one column per component type
+        size_t count = 0;               // rows in use
+    };
+
+    class Archetype
+    {
+    public:
+        Archetype(const Signature& signature, const std::vector<ComponentColumnInfo>& columnInfos);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        // appends a row for the entity, the component memory of the row is left unconstructed
+        size_t PushRow(Entity entity);
+
+        // destroys the components of the row and fills the hole with the last row
+        // returns the entity that was moved into the row, or INVALID_ENTITY if nothing moved
+        Entity RemoveRow(size_t row);
+
+        inline void* GetComponentPtr(ComponentType type, size_t row)
+        {
+            assert(mSignature.test(type) && "Error : Archetype doesn't contain this component.");
+
+            ArchetypeChunk& chunk = aChunks[row / mChunkCapacity];
+            return chunk.pMemory + aColumnOffsets[type] + (row % mChunkCapacity) * aColumnInfos[type].size;
+        }
+
+        inline Entity GetEntity(size_t row) const
+        {
+            const ArchetypeChunk& chunk = aChunks[row / mChunkCapacity];
+            return reinterpret_cast<const Entity*>(chunk.pMemory)[row % mChunkCapacity];
+        }
+
+        // direct chunk access, this is what the iteration walks through
+        inline size_t ChunkCount() const { return aChunks.size(); }
+        inline ArchetypeChunk& GetChunk(size_t index) { return aChunks[index]; }
+
+        inline Entity* GetEntityColumn(ArchetypeChunk& chunk) { return reinterpret_cast<Entity*>(chunk.pMemory); }
+
+        template<typename T>
+        inline T* GetColumn(ArchetypeChunk& chunk, ComponentType type)
+        {
+            return reinterpret_cast<T*>(chunk.pMemory + aColumnOffsets[type]);
+        }
+
+        inline size_t Size() const { return mSize; }
+        inline size_t ChunkCapacity() const { return mChunkCapacity; }
+        inline const Signature& GetSignature() const { return mSignature; }
+        inline const std::vector<ComponentType>& GetTypes() const { return aTypes; }
+
+        // cached archetype transitions when a component is added / removed
+        std::array<size_t, MAX_COMPONENTS> aAddEdges;
+        std::array<size_t, MAX_COMPONENTS> aRemoveEdges;
+
+    private:
+        void AllocateChunk();
+
+        Signature mSignature;
+        std::vector<ComponentType> aTypes;
+
+        // the column infos are owned by the storage, copied here for locality
+        std::array<ComponentColumnInfo, MAX_COMPONENTS> aColumnInfos{};
+        std::array<size_t, MAX_COMPONENTS> aColumnOffsets{};
+
+        std::vector<ArchetypeChunk> aChunks;
+
+        size_t mChunkCapacity = 1;
+        size_t mChunkBytes = ARCHETYPE_CHUNK_SIZE;
+        size_t mChunkAlignment = alignof(std::max_align_t);
+        size_t mSize = 0;
+    };
+
+    class ArchetypeStorage
+    {
+    public:
+        ArchetypeStorage();
+
+        template<typename T>
+        void RegisterComponent(ComponentType type)
+        {
+            assert(type < MAX_COMPONENTS && "Error : Component type out of range.");
+
+            if (aColumnInfos.size() <= type)
+            {
+                aColumnInfos.resize(type + 1);
+            }
+
+            aColumnInfos[type] = ComponentColumnInfo::Create<T>();
+        }
+
+        // entity lifetime
+        void CreateEntity(Entity entity);
+        void DestroyEntity(Entity entity);
+        void CloneEntity(Entity src, Entity dest);
+
+        // batched versions, the entities go straight into the archetype of signature / src
+        void CreateEntities(const std::vector<Entity>& entities, const Signature& signature);
+        void CloneEntity(Entity src, const std::vector<Entity>& dests);
+
+        template<typename T>
+        void AddComponent(Entity entity, ComponentType type, const T& component)
+        {
+            EmplaceComponent<T>(entity, type, component);
+        }
+
+        // constructs the component straight into its column of the destination archetype
+        template<typename T, typename... Args>
+        void EmplaceComponent(Entity entity, ComponentType type, Args&&... args)
+        {
+            assert(!Has(entity, type) && "Error : Same component is being added again.");
+
+            EntityRecord& record = aRecords[entity];
+            size_t dst = aArchetypes[record.archetype]->aAddEdges[type];
+
+            if (dst == INVALID_ARCHETYPE)
+            {
+                Signature signature = aArchetypes[record.archetype]->GetSignature();
+                signature.set(type);
+
+                dst = GetOrCreateArchetype(signature);
+                aArchetypes[record.archetype]->aAddEdges[type] = dst;
+                aArchetypes[dst]->aRemoveEdges[type] = record.archetype;
+            }
+
+            size_t row = MoveEntity(entity, dst);
+            new (aArchetypes[dst]->GetComponentPtr(type, row)) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        void RemoveComponent(Entity entity, ComponentType type)
+        {
+            assert(Has(entity, type) && "Error : This entity doesn't contain this component.");
+
+            EntityRecord& record = aRecords[entity];
+            size_t dst = aArchetypes[record.archetype]->aRemoveEdges[type];
+
+            if (dst == INVALID_ARCHETYPE)
+            {
+                Signature signature = aArchetypes[record.archetype]->GetSignature();
+                signature.reset(type);
+
+                dst = GetOrCreateArchetype(signature);
+                aArchetypes[record.archetype]->aRemoveEdges[type] = dst;
+                aArchetypes[dst]->aAddEdges[type] = record.archetype;
+            }
+
+            // the removed column is not moved, RemoveRow destroys it with the old row
+            MoveEntity(entity, dst);
+        }
+
+        template<typename T>
+        T& GetComponent(Entity entity, ComponentType type)
+        {
+            assert(Has(entity, type) && "ERROR : Entity doesnt contain this data.");
+
+            const EntityRecord& record = aRecords[entity];
+            return *static_cast<T*>(aArchetypes[record.archetype]->GetComponentPtr(type, record.row));
+        }
+
+        bool Has(Entity entity, ComponentType type) const
+        {
+            if (entity >= aRecords.size() || aRecords[entity].archetype == INVALID_ARCHETYPE) return false;
+
+            return aArchetypes[aRecords[entity].archetype]->GetSignature().test(type);
+        }
+
+        // walks every archetype that contains all the requested types, chunk by chunk
+        // func is called as func(Entity, Ts&...)
+        template<typename... Ts, typename Func>
+        void ForEach(const std::array<ComponentType, sizeof...(Ts)>& types, Func&& func)
+        {
+            Signature required;
+            for (ComponentType type : types)
+            {
+                required.set(type);
+            }
+
+            for (auto& archetype : aArchetypes)
+            {
+                if (archetype->Size() == 0 || !archetype->GetSignature().Contains(required)) continue;
+
+                for (size_t c = 0; c < archetype->ChunkCount(); ++c)
+                {
+                    ArchetypeChunk& chunk = archetype->GetChunk(c);
+                    IterateChunk<Ts...>(*archetype, chunk, types, func, std::index_sequence_for<Ts...>{});
+                }
+            }
+        }
+
+        void Clear();
+
+        inline size_t GetArchetypeCount() const { return aArchetypes.size(); }
+
+    private:
+        struct EntityRecord
+        {
+            size_t archetype = INVALID_ARCHETYPE;
+            size_t row = 0;
+        };
+
+        template<typename... Ts, typename Func, size_t... Is>
+        void IterateChunk(Archetype& archetype, ArchetypeChunk& chunk,
+            const std::array<ComponentType, sizeof...(Ts)>& types, Func& func, std::index_sequence<Is...>)
+        {
+            Entity* entities = archetype.GetEntityColumn(chunk);
+            std::tuple<Ts*...> columns{ archetype.GetColumn<Ts>(chunk, types[Is])... };
+
+            for (size_t r = 0; r < chunk.count; ++r)
+            {
+                func(entities[r], std::get<Is>(columns)[r]...);
+            }
+        }
+
+        size_t GetOrCreateArchetype(const Signature& signature);
+
+        // moves the entity and its shared columns into the dst archetype, returns the new row
+        size_t MoveEntity(Entity entity, size_t dst);
+
+        std::vector<std::unique_ptr<Archetype>> aArchetypes;
+        std::unordered_map<Signature, size_t> aArchetypeLookup;
+
+        std::vector<ComponentColumnInfo> aColumnInfos;
+        std::vector<EntityRecord> aRecords;
+    };
+}
@@ -10,13 +10,12 @@
 \par    DigiPen login: waimen.leong
 
 \brief
-Implements a packed array storage container for components of a specific type using template-based design.
+Implements a paged sparse-set storage container for components of a specific type using template-based design.
 
-Provides O(1) component access through entity-to-index mapping with contiguous memory layout for cache efficiency.
-Components are tightly packed by swapping removed elements with the last element to maintain density.
-Includes serialization/deserialization support via RapidJSON and component cloning for entity duplication.
-Base class (BaseComponentArray) enables polymorphic storage of different component types in a single container.
-Supports up to MAX_ENTITIES components with entity existence checking and boundary validation.
+Components stay packed (swap and pop on removal) and are added by copy, move or in place, the entity-to-index map is
+paged so memory follows the live component count. Every slot carries the ChangeTick of its last tracked write. Types
+with a HotData specialisation keep their runtime half in a packed hot array, DoubleBuffered types keep a previous
+buffer refreshed by SwapBuffers. Also provides serialization, prefab capture, defragmentation and listeners.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -25,15 +24,36 @@ All rights reserved.
 #pragma once
 
 #include "Types.hpp"
+#include "Prefab.hpp"
 #include <array>
+#include <vector>
+#include <memory>
 #include <unordered_map>
 #include <cassert>
 #include <string>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
 
 #include "rapidjson/document.h"		// rapidjson's DOM-style API
 
 namespace Uma_ECS
 {
+    // number of entity ids covered by one page of the sparse entity-to-index map
+    const size_t SPARSE_PAGE_SIZE = 4096;
+
+    // memory used by one component pool, only counts the memory owned by the pool itself
+    struct PoolMemoryReport
+    {
+        size_t componentCount = 0;  // live components
+        size_t denseCapacity = 0;   // reserved slots in the dense arrays
+        size_t denseBytes = 0;      // components + index-to-entity + change ticks (+ hot records)
+        size_t sparsePages = 0;     // allocated pages of the entity-to-index map
+        size_t sparseBytes = 0;     // pages + page table
+
+        inline size_t TotalBytes() const { return denseBytes + sparseBytes; }
+    };
+
     class BaseComponentArray
     {
     public:
@@ -41,27 +61,96 @@ namespace Uma_ECS
         virtual void DestroyEntity(Entity entity) = 0; // detroy of entity shd be handled by the child
 
         virtual bool Has(Entity entity) const = 0;
+
+        // true if the entity owns the component and it was added / written after since
+        virtual bool ChangedSince(Entity entity, ChangeTick since) const = 0;
+
+        // stamps the entity's component with the current tick
+        virtual void MarkChanged(Entity entity) = 0;
         virtual void CloneComponent(Entity src, Entity dest) = 0;
 
+        // batched versions, the pool grows once for the whole batch
+        virtual void AddDefaultData(const std::vector<Entity>& entities) = 0;
+        virtual void CloneComponent(Entity src, const std::vector<Entity>& dests) = 0;
+
+        // drops every component without touching the entities one by one
+        virtual void Clear() = 0;
+
+        // moves the components towards ascending entity order with at most maxMoves swaps
+        // true once the pool is in order, every pool stored this way keeps shared entities in the same relative order
+        virtual bool DefragmentStep(size_t maxMoves) = 0;
+
+        virtual PoolMemoryReport GetMemoryReport() const = 0;
+
+        // publishes the current components as the previous buffer, nothing for pools that aren't double buffered
+        virtual void SwapBuffers() = 0;
+
         // serialization and deserialization
         virtual void Serialize(Entity entity, rapidjson::Value& comps, rapidjson::Document::AllocatorType& allocator) = 0;
         virtual std::string Deserialize(Entity entity, const rapidjson::Value& comps) = 0;
+
+        // prefab templates, a copy of the entity's component / the component read from comps, nullptr if absent
+        virtual std::unique_ptr<BasePrefabComponent> CapturePrefab(Entity entity) const = 0;
+        virtual std::unique_ptr<BasePrefabComponent> DeserializePrefab(const rapidjson::Value& comps) const = 0;
+
+        // world tick the pool stamps its writes with, owned by the ComponentManager
+        inline void SetTickSource(const ChangeTick* tick) { pChangeTick = tick; }
+
+    protected:
+        inline ChangeTick CurrentTick() const { return pChangeTick ? *pChangeTick : 0; }
+
+        const ChangeTick* pChangeTick = nullptr;
+    };
+
+    // hot record of the components that aren't split, never stored
+    struct NoHotData {};
+
+    // notified by the ComponentArray<T> that owns it (ComponentIndex, ComponentObserver)
+    template<typename T>
+    class ComponentListener
+    {
+    public:
+        virtual ~ComponentListener() = default;
+
+        virtual void OnAdd(Entity entity, const T& component) = 0;
+        virtual void OnRemove(Entity entity) = 0;
+
+        // tracked write, the component can still be written so its key is read later
+        virtual void OnChanged(Entity entity) = 0;
+        virtual void OnClear() = 0;
     };
 
     template <typename T>
     class ComponentArray : public BaseComponentArray
     {
     public:
+        // runtime half of a split component, NoHotData otherwise
+        static constexpr bool HAS_HOT_DATA = !std::is_void_v<typename HotData<T>::type>;
+        using Hot = std::conditional_t<HAS_HOT_DATA, typename HotData<T>::type, NoHotData>;
 
-        ComponentArray()
-        {
-            aEntityToIndex.fill(MAX_ENTITIES);
-            aIndexToEntity.fill(MAX_ENTITIES);
-        }
+        static_assert(std::is_trivially_copyable_v<Hot>, "Error : Hot component data must be trivially copyable.");
+
+        // keeps a previous buffer, see SwapBuffers
+        static constexpr bool DOUBLE_BUFFERED = DoubleBuffered<T>::value;
+
+        ComponentArray() = default;
 
         // Add / Remove Component from the array
         ECSErrorCode AddData(Entity entity, const T& component)
         {
+            return EmplaceData(entity, component);
+        }
+
+        // the component is moved in, a component owning heap memory hands it over without allocating
+        ECSErrorCode AddData(Entity entity, T&& component)
+        {
+            return EmplaceData(entity, std::move(component));
+        }
+
+        // constructs the component in place at the end of the dense array from args
+        template<typename... Args>
+        ECSErrorCode EmplaceData(Entity entity, Args&&... args)
+        {
 #ifndef NDEBUG
             assert(!Has(entity) && "Error : Same component is being added again.");
 #else
@@ -71,11 +160,93 @@ namespace Uma_ECS
             }
 #endif
 
-            size_t index = mSize;
-            aEntityToIndex[entity] = index;
-            aIndexToEntity[index] = entity;
-            aComponentArray[index] = component;
-            ++mSize;
+            Entity index = static_cast<Entity>(aComponentArray.size());
+            if (index > 0 && entity < aIndexToEntity.back()) mEntityOrdered = false;
+            ++mStructureVersion;
+
+            aComponentArray.emplace_back(std::forward<Args>(args)...);
+            aIndexToEntity.push_back(entity);
+            aChangeTicks.push_back(CurrentTick());
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                ValidateHot(aComponentArray.back());
+                HotData<T>::Sync(aComponentArray.back(), aHotArray.emplace_back());
+            }
+
+            // readers see the component as added until the next swap
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                aPrevArray.push_back(aComponentArray.back());
+            }
+
+            SparsePage& page = GetOrCreatePage(entity);
+            page.aIndices[entity % SPARSE_PAGE_SIZE] = index;
+            ++page.mCount;
+
+            for (auto& listener : aListeners)
+            {
+                listener->OnAdd(entity, aComponentArray[index]);
+            }
+
+            return ECSErrorCode::EC_None;
+        }
+
+        // adds a copy of component to every entity, the dense arrays grow once
+        // the copies are filled in one go, a plain memory fill for trivially copyable components
+        ECSErrorCode AddData(const std::vector<Entity>& entities, const T& component)
+        {
+            for (Entity entity : entities)
+            {
+#ifndef NDEBUG
+                assert(!Has(entity) && "Error : Same component is being added again.");
+#else
+                if (Has(entity))
+                {
+                    return ECSErrorCode::EC_ComponentAlreadyExists;
+                }
+#endif
+            }
+
+            Entity index = static_cast<Entity>(aComponentArray.size());
+            if (!entities.empty() && ((index > 0 && entities.front() < aIndexToEntity.back())
+                || !std::is_sorted(entities.begin(), entities.end())))
+            {
+                mEntityOrdered = false;
+            }
+            ++mStructureVersion;
+
+            aComponentArray.insert(aComponentArray.end(), entities.size(), component);
+            aIndexToEntity.insert(aIndexToEntity.end(), entities.begin(), entities.end());
+            aChangeTicks.insert(aChangeTicks.end(), entities.size(), CurrentTick());
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                Hot hot{};
+                ValidateHot(component);
+                HotData<T>::Sync(component, hot);
+                aHotArray.insert(aHotArray.end(), entities.size(), hot);
+            }
+
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                aPrevArray.insert(aPrevArray.end(), entities.size(), component);
+            }
+
+            for (Entity entity : entities)
+            {
+                SparsePage& page = GetOrCreatePage(entity);
+                page.aIndices[entity % SPARSE_PAGE_SIZE] = index++;
+                ++page.mCount;
+            }
+
+            for (auto& listener : aListeners)
+            {
+                for (Entity entity : entities)
+                {
+                    listener->OnAdd(entity, component);
+                }
+            }
 
             return ECSErrorCode::EC_None;
         }
@@ -90,22 +261,61 @@ namespace Uma_ECS
                 return ECSErrorCode::EC_ComponentNotFound;
             }
 #endif
-            size_t index_to_remove = aEntityToIndex[entity];
-            size_t last_index = mSize - 1;
+            for (auto& listener : aListeners)
+            {
+                listener->OnRemove(entity);
+            }
 
-            // move last to the remove index
-            aComponentArray[index_to_remove] = aComponentArray[last_index];
-            // find last entity
-            Entity last_entity = aIndexToEntity[last_index];
-            // swap their locations
-            aEntityToIndex[last_entity] = index_to_remove;
-            aIndexToEntity[index_to_remove] = last_entity;
+            Entity index_to_remove = GetIndex(entity);
+            Entity last_index = static_cast<Entity>(aComponentArray.size() - 1);
+            ++mStructureVersion;
 
-            // Clear the removed entity's mapping
-            aEntityToIndex[entity] = 0;
-            aIndexToEntity[last_index] = 0;  // Clear the now-unused slot
+            if (index_to_remove != last_index)
+            {
+                // the last entity lands in the middle
+                mEntityOrdered = false;
+
+                // move last to the remove index, no copy of the heap memory it owns
+                aComponentArray[index_to_remove] = std::move(aComponentArray[last_index]);
+                // find last entity
+                Entity last_entity = aIndexToEntity[last_index];
+                // swap their locations
+                aPages[last_entity / SPARSE_PAGE_SIZE]->aIndices[last_entity % SPARSE_PAGE_SIZE] = index_to_remove;
+                aIndexToEntity[index_to_remove] = last_entity;
+                aChangeTicks[index_to_remove] = aChangeTicks[last_index];
+
+                if constexpr (HAS_HOT_DATA)
+                {
+                    aHotArray[index_to_remove] = aHotArray[last_index];
+                }
+
+                if constexpr (DOUBLE_BUFFERED)
+                {
+                    aPrevArray[index_to_remove] = std::move(aPrevArray[last_index]);
+                }
+            }
 
-            --mSize;
+            aComponentArray.pop_back();
+            aIndexToEntity.pop_back();
+            aChangeTicks.pop_back();
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                aHotArray.pop_back();
+            }
+
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                aPrevArray.pop_back();
+            }
+
+            // Clear the removed entity's mapping, the page is released once nothing in it is used
+            std::unique_ptr<SparsePage>& page = aPages[entity / SPARSE_PAGE_SIZE];
+            page->aIndices[entity % SPARSE_PAGE_SIZE] = INVALID_ENTITY;
+            if (--page->mCount == 0)
+            {
+                page.reset();
+            }
 
             return ECSErrorCode::EC_None;
         }
@@ -114,10 +324,186 @@ namespace Uma_ECS
         {
             assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
 
-            size_t index = aEntityToIndex[entity];
+            return aComponentArray[GetIndex(entity)];
+        }
+
+        // mutable accessor, stamps the component as changed at the current tick
+        T& GetMutable(Entity entity)
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            Entity index = GetIndex(entity);
+            aChangeTicks[index] = CurrentTick();
+            NotifyChanged(entity);
             return aComponentArray[index];
         }
 
+        // for writes made through GetData / GetComponentAt / a view
+        void MarkChanged(Entity entity) override
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            aChangeTicks[GetIndex(entity)] = CurrentTick();
+            NotifyChanged(entity);
+        }
+
+        inline void MarkChangedAt(size_t index)
+        {
+            aChangeTicks[index] = CurrentTick();
+            NotifyChanged(aIndexToEntity[index]);
+        }
+
+        ChangeTick GetChangeTick(Entity entity) const
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            return aChangeTicks[GetIndex(entity)];
+        }
+
+        inline ChangeTick GetChangeTickAt(size_t index) const
+        {
+            return aChangeTicks[index];
+        }
+
+        bool ChangedSince(Entity entity, ChangeTick since) const override
+        {
+            Entity index = GetIndex(entity);
+            return index != INVALID_ENTITY && aChangeTicks[index] > since;
+        }
+
+        // nullptr if the entity doesn't own this component, one sparse lookup instead of Has + GetData
+        T* TryGetData(Entity entity)
+        {
+            Entity index = GetIndex(entity);
+            return index != INVALID_ENTITY ? &aComponentArray[index] : nullptr;
+        }
+
+        // Hot / cold split (components with a HotData specialisation)
+
+        Hot& GetHot(Entity entity)
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            return aHotArray[GetIndex(entity)];
+        }
+
+        Hot* TryGetHot(Entity entity)
+        {
+            Entity index = GetIndex(entity);
+            return index != INVALID_ENTITY ? &aHotArray[index] : nullptr;
+        }
+
+        // hot half of a component reached through a view or GetComponentAt, found from its slot without a lookup
+        Hot& GetHot(const T& component)
+        {
+            assert(&component >= aComponentArray.data() && &component < aComponentArray.data() + aComponentArray.size()
+                && "ERROR : Component doesnt belong to this pool.");
+
+            return aHotArray[static_cast<size_t>(&component - aComponentArray.data())];
+        }
+
+        inline Hot& GetHotAt(size_t index)
+        {
+            return aHotArray[index];
+        }
+
+        // packed hot records, same order as the components
+        inline const std::vector<Hot>& GetHotArray() const
+        {
+            return aHotArray;
+        }
+
+        // re-syncs the hot record of every component added / written through a tracked accessor since the last call
+        // untracked writes (GetData, GetComponentAt) need a MarkChanged to show up, runtime only hot fields are kept
+        void SyncHot()
+        {
+            if constexpr (HAS_HOT_DATA)
+            {
+                // >= so a write made after the previous sync within the same tick isn't missed, syncing twice is harmless
+                for (size_t i = 0; i < aChangeTicks.size(); ++i)
+                {
+                    if (aChangeTicks[i] >= mHotSyncTick)
+                    {
+                        HotData<T>::Sync(aComponentArray[i], aHotArray[i]);
+                    }
+                }
+
+                mHotSyncTick = CurrentTick();
+            }
+        }
+
+        // Double buffering (components marked DoubleBuffered)
+
+        // the entity's component as of the last SwapBuffers, safe to read while the current buffer is written
+        const T& GetPrevious(Entity entity) const
+        {
+            static_assert(DOUBLE_BUFFERED, "Error : Component is not double buffered.");
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            return aPrevArray[GetIndex(entity)];
+        }
+
+        // previous state of a component reached through a view or GetComponentAt, found from its slot without a lookup
+        const T& GetPrevious(const T& component) const
+        {
+            static_assert(DOUBLE_BUFFERED, "Error : Component is not double buffered.");
+            assert(&component >= aComponentArray.data() && &component < aComponentArray.data() + aComponentArray.size()
+                && "ERROR : Component doesnt belong to this pool.");
+
+            return aPrevArray[static_cast<size_t>(&component - aComponentArray.data())];
+        }
+
+        const T* TryGetPrevious(Entity entity) const
+        {
+            static_assert(DOUBLE_BUFFERED, "Error : Component is not double buffered.");
+
+            Entity index = GetIndex(entity);
+            return index != INVALID_ENTITY ? &aPrevArray[index] : nullptr;
+        }
+
+        inline const T& GetPreviousAt(size_t index) const
+        {
+            static_assert(DOUBLE_BUFFERED, "Error : Component is not double buffered.");
+
+            return aPrevArray[index];
+        }
+
+        // packed previous buffer, same order as the components
+        inline const std::vector<T>& GetPreviousArray() const
+        {
+            static_assert(DOUBLE_BUFFERED, "Error : Component is not double buffered.");
+
+            return aPrevArray;
+        }
+
+        // end of frame sync point, the current components become the previous buffer (a memory copy for trivially
+        // copyable components), no reader or writer may run meanwhile
+        // adds / removes keep both buffers packed in the same order, so they still go through the command buffer
+        void SwapBuffers() override
+        {
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                std::copy(aComponentArray.begin(), aComponentArray.end(), aPrevArray.begin());
+            }
+        }
+
+        // Listeners
+
+        // the pool owns the listener and notifies it from now on, the current components are passed to it as adds
+        template<typename Listener>
+        Listener& AddListener(std::unique_ptr<Listener> listener)
+        {
+            Listener& ref = *listener;
+
+            for (size_t i = 0; i < aComponentArray.size(); ++i)
+            {
+                ref.OnAdd(aIndexToEntity[i], aComponentArray[i]);
+            }
+
+            aListeners.push_back(std::move(listener));
+            return ref;
+        }
+
         // Destroy of entity
         void DestroyEntity(Entity entity) override
         {
@@ -131,7 +517,7 @@ namespace Uma_ECS
         // This is for optimisation
         size_t Size() const
         {
-            return mSize;
+            return aComponentArray.size();
         }
 
         Entity GetEntity(size_t index) 
@@ -139,6 +525,12 @@ namespace Uma_ECS
             return aIndexToEntity[index];
         }
 
+        // packed entity list, same order as the components
+        const std::vector<Entity>& GetEntities() const
+        {
+            return aIndexToEntity;
+        }
+
         T& GetComponentAt(size_t index)
         {
             return aComponentArray[index];
@@ -146,18 +538,126 @@ namespace Uma_ECS
 
         bool Has(Entity entity) const override
         {
-            if (entity >= MAX_ENTITIES) return false;
-
-            size_t index = aEntityToIndex[entity];
-            return (index < mSize && aIndexToEntity[index] == entity);
+            return GetIndex(entity) != INVALID_ENTITY;
         }
 
         void CloneComponent(Entity src, Entity dest) override
         {
             assert(Has(src) && "Error : src entity doesn't contain this component type.");
 
+            // copied once out of the array, the add can reallocate it, then moved in
             T component = GetData(src);
-            AddData(dest, component);
+            EmplaceData(dest, std::move(component));
+        }
+
+        void AddDefaultData(const std::vector<Entity>& entities) override
+        {
+            AddData(entities, T{});
+        }
+
+        void CloneComponent(Entity src, const std::vector<Entity>& dests) override
+        {
+            assert(Has(src) && "Error : src entity doesn't contain this component type.");
+
+            // copied out first, the fill can reallocate the array src lives in
+            T component = GetData(src);
+            AddData(dests, component);
+        }
+
+        void Clear() override
+        {
+            // the dense capacity is kept for the next scene, the sparse pages are released
+            aComponentArray.clear();
+            aIndexToEntity.clear();
+            aChangeTicks.clear();
+            aHotArray.clear();
+            aPrevArray.clear();
+            aPages.clear();
+
+            aDefragOrder.clear();
+            mEntityOrdered = true;
+            ++mStructureVersion;
+
+            for (auto& listener : aListeners)
+            {
+                listener->OnClear();
+            }
+        }
+
+        // selection by swaps against the entity list in ascending order, the plan is redone when components were
+        // added / removed since it was made, slots already holding the right entity cost one compare
+        bool DefragmentStep(size_t maxMoves) override
+        {
+            if (mEntityOrdered) return true;
+
+            if (aDefragOrder.empty() || mDefragVersion != mStructureVersion)
+            {
+                // the sparse pages already list the entities in ascending order, no sort needed
+                aDefragOrder.clear();
+                aDefragOrder.reserve(aIndexToEntity.size());
+
+                for (size_t pageIndex = 0; pageIndex < aPages.size(); ++pageIndex)
+                {
+                    if (!aPages[pageIndex]) continue;
+
+                    const auto& indices = aPages[pageIndex]->aIndices;
+                    for (size_t slot = 0; slot < SPARSE_PAGE_SIZE; ++slot)
+                    {
+                        if (indices[slot] != INVALID_ENTITY)
+                        {
+                            aDefragOrder.push_back(static_cast<Entity>(pageIndex * SPARSE_PAGE_SIZE + slot));
+                        }
+                    }
+                }
+
+                mDefragCursor = 0;
+                mDefragVersion = mStructureVersion;
+            }
+
+            for (; mDefragCursor < aDefragOrder.size() && maxMoves > 0; ++mDefragCursor)
+            {
+                Entity index = GetIndex(aDefragOrder[mDefragCursor]);
+                if (index == mDefragCursor) continue;
+
+                SwapSlots(index, static_cast<Entity>(mDefragCursor));
+                --maxMoves;
+            }
+
+            if (mDefragCursor < aDefragOrder.size()) return false;
+
+            aDefragOrder.clear();
+            mEntityOrdered = true;
+            return true;
+        }
+
+        // true while the dense arrays are in ascending entity order
+        inline bool IsEntityOrdered() const { return mEntityOrdered; }
+
+        PoolMemoryReport GetMemoryReport() const override
+        {
+            PoolMemoryReport report;
+            report.componentCount = aComponentArray.size();
+            report.denseCapacity = aComponentArray.capacity();
+            report.denseBytes = aComponentArray.capacity() * sizeof(T) + aIndexToEntity.capacity() * sizeof(Entity)
+                + aChangeTicks.capacity() * sizeof(ChangeTick) + aDefragOrder.capacity() * sizeof(Entity);
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                report.denseBytes += aHotArray.capacity() * sizeof(Hot);
+            }
+
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                report.denseBytes += aPrevArray.capacity() * sizeof(T);
+            }
+
+            for (const auto& page : aPages)
+            {
+                if (page) ++report.sparsePages;
+            }
+            report.sparseBytes = report.sparsePages * sizeof(SparsePage) + aPages.capacity() * sizeof(std::unique_ptr<SparsePage>);
+
+            return report;
         }
 
         // serialization and deserialization
@@ -165,7 +665,7 @@ namespace Uma_ECS
         {
             if (!Has(entity)) return; // entity not exists
 
-            T& component = aComponentArray[aEntityToIndex[entity]];
+            T& component = aComponentArray[GetIndex(entity)];
             rapidjson::Value componentObj;
             component.Serialize(componentObj, allocator);
             comps.AddMember(rapidjson::StringRef(typeid(T).name()), componentObj, allocator);
@@ -178,24 +678,139 @@ namespace Uma_ECS
             {
                 T component;
                 component.Deserialize(comps[typeid(T).name()]);
-                AddData(entity, component);
+                AddData(entity, std::move(component));
 
                 compType = typeid(T).name();
             }
             return compType;
         }
 
+        std::unique_ptr<BasePrefabComponent> CapturePrefab(Entity entity) const override
+        {
+            if (!Has(entity)) return nullptr;
+
+            return std::make_unique<PrefabComponent<ComponentArray<T>, T>>(aComponentArray[GetIndex(entity)]);
+        }
+
+        std::unique_ptr<BasePrefabComponent> DeserializePrefab(const rapidjson::Value& comps) const override
+        {
+            if (!comps.HasMember(typeid(T).name())) return nullptr;
+
+            T component;
+            component.Deserialize(comps[typeid(T).name()]);
+            return std::make_unique<PrefabComponent<ComponentArray<T>, T>>(std::move(component));
+        }
+
     private:
 
-        // the container that stores all components of the same type of all entities
-        std::array<T, MAX_ENTITIES> aComponentArray{};
+        // one page of the entity-to-index map, unused slots hold INVALID_ENTITY
+        struct SparsePage
+        {
+            SparsePage() { aIndices.fill(INVALID_ENTITY); }
+
+            std::array<Entity, SPARSE_PAGE_SIZE> aIndices;
+            size_t mCount = 0; // used slots, the page is freed when this drops to 0
+        };
+
+        // dense index of the entity, INVALID_ENTITY if the entity doesn't own this component
+        inline Entity GetIndex(Entity entity) const
+        {
+            size_t pageIndex = entity / SPARSE_PAGE_SIZE;
+            if (pageIndex >= aPages.size() || !aPages[pageIndex]) return INVALID_ENTITY;
+
+            return aPages[pageIndex]->aIndices[entity % SPARSE_PAGE_SIZE];
+        }
+
+        // exchanges two dense slots and fixes the sparse map, the components are moved, not copied
+        void SwapSlots(Entity a, Entity b)
+        {
+            using std::swap;
+            swap(aComponentArray[a], aComponentArray[b]);
+            swap(aIndexToEntity[a], aIndexToEntity[b]);
+            swap(aChangeTicks[a], aChangeTicks[b]);
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                swap(aHotArray[a], aHotArray[b]);
+            }
+
+            if constexpr (DOUBLE_BUFFERED)
+            {
+                swap(aPrevArray[a], aPrevArray[b]);
+            }
+
+            Entity entityA = aIndexToEntity[a];
+            Entity entityB = aIndexToEntity[b];
+            aPages[entityA / SPARSE_PAGE_SIZE]->aIndices[entityA % SPARSE_PAGE_SIZE] = a;
+            aPages[entityB / SPARSE_PAGE_SIZE]->aIndices[entityB % SPARSE_PAGE_SIZE] = b;
+        }
 
-        std::array<Entity, MAX_ENTITIES> aIndexToEntity{};
-        std::array<size_t, MAX_ENTITIES> aEntityToIndex{};
+        // lets a split component report what its hot half can't hold, see HotData
+        static inline void ValidateHot(const T& component)
+        {
+            if constexpr (requires { HotData<T>::Validate(component); })
+            {
+                HotData<T>::Validate(component);
+            }
+        }
 
-        size_t mSize = 0; // how many components are currently in use
+        inline void NotifyChanged(Entity entity)
+        {
+            for (auto& listener : aListeners)
+            {
+                listener->OnChanged(entity);
+            }
+        }
+
+        SparsePage& GetOrCreatePage(Entity entity)
+        {
+            size_t pageIndex = entity / SPARSE_PAGE_SIZE;
+            if (pageIndex >= aPages.size())
+            {
+                aPages.resize(pageIndex + 1);
+            }
+
+            if (!aPages[pageIndex])
+            {
+                aPages[pageIndex] = std::make_unique<SparsePage>();
+            }
+
+            return *aPages[pageIndex];
+        }
+
+        // the container that stores all components of the same type of all entities, packed
+        std::vector<T> aComponentArray;
+        std::vector<Entity> aIndexToEntity;
+
+        // tick of the last add / tracked write, same order as the components
+        std::vector<ChangeTick> aChangeTicks;
+
+        // runtime half of split components, same order as the components, always empty for the others
+        std::vector<Hot> aHotArray;
+
+        // tick of the last SyncHot
+        ChangeTick mHotSyncTick = 0;
+
+        // state published by the last SwapBuffers, same order as the components, always empty for the others
+        std::vector<T> aPrevArray;
+
+        // entity-to-index map split into pages, only pages with live components are allocated
+        std::vector<std::unique_ptr<SparsePage>> aPages;
+
+        // false once an add / swap-remove broke the ascending entity order
+        bool mEntityOrdered = true;
+
+        // bumped by every add / remove, a defragment plan made for an older version is redone
+        size_t mStructureVersion = 0;
+
+        // entities in the order the defragmenter is moving them to, empty when no defragment is in progress
+        std::vector<Entity> aDefragOrder;
+        size_t mDefragCursor = 0;
+        size_t mDefragVersion = 0;
+
+        // indexes / observers of this pool, empty unless one was created
+        std::vector<std::unique_ptr<ComponentListener<T>>> aListeners;
     };
 
 }
 
-
@@ -0,0 +1,220 @@
+/*!
+\file   ComponentIndex.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements ComponentIndex, an opt-in secondary index grouping the entities of a component pool by a key read from
+their component (render layer, texture name, collision layer, ...).
+
+The index is owned by the ComponentArray it indexes and kept up to date incrementally. Adds and removes are applied
+right away, tracked writes (GetMutable / MarkChanged) only flag the entity and its key is re-read at the next query,
+so a component can be written freely after GetComponent returned it. Writes through GetData / GetComponentAt / a view
+need a MarkChanged to be picked up, same as change tracking.
+Keys are kept sorted in buckets, each with the packed list of its entities, so a lookup costs a binary search over
+the keys plus the results and walking the buckets gives the entities in key order without sorting.
+Disabled entities stay indexed, the caller skips them.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include "ComponentArray.hpp"
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+namespace Uma_ECS
+{
+    template<typename T, typename Key>
+    class ComponentIndex : public ComponentListener<T>
+    {
+    public:
+        // reads the key of a component, Key needs operator< and operator==
+        using KeyFunc = Key(*)(const T&);
+
+        ComponentIndex(ComponentArray<T>& pool, KeyFunc keyFunc)
+            : pPool(&pool), mKeyFunc(keyFunc)
+        {
+            assert(mKeyFunc && "Error : A component index needs a key function.");
+        }
+
+        // entities whose key equals key, empty if none
+        const std::vector<Entity>& Find(const Key& key)
+        {
+            Refresh();
+
+            auto it = LowerBound(key);
+            return it != aBuckets.end() && it->key == key ? it->aEntities : aNoEntities;
+        }
+
+        inline size_t Count(const Key& key) { return Find(key).size(); }
+
+        // calls func(const Key&, const std::vector<Entity>&) for every key in ascending order
+        template<typename Func>
+        void ForEach(Func&& func)
+        {
+            Refresh();
+
+            for (const Bucket& bucket : aBuckets)
+            {
+                if (!bucket.aEntities.empty()) func(bucket.key, bucket.aEntities);
+            }
+        }
+
+        // same, only for the keys where pred(key) is true
+        // eg. byLayer.ForEachWhere([](LayerMask layer) { return (layer & CL_WALL) != 0; }, func);
+        template<typename Pred, typename Func>
+        void ForEachWhere(Pred&& pred, Func&& func)
+        {
+            Refresh();
+
+            for (const Bucket& bucket : aBuckets)
+            {
+                if (!bucket.aEntities.empty() && pred(bucket.key)) func(bucket.key, bucket.aEntities);
+            }
+        }
+
+        // distinct keys seen so far, empty ones included
+        inline size_t KeyCount() const { return aBuckets.size(); }
+
+        // re-reads the key of the entities written since the last query, called by every query
+        void Refresh()
+        {
+            for (Entity entity : aDirty)
+            {
+                Slot& slot = aSlots[entity];
+                if (!slot.dirty) continue;
+
+                slot.dirty = false;
+                if (slot.bucket == INVALID_ENTITY) continue;
+
+                Key key = mKeyFunc(pPool->GetData(entity));
+                if (aBuckets[slot.bucket].key == key) continue;
+
+                Erase(entity);
+                Insert(entity, key);
+            }
+
+            aDirty.clear();
+        }
+
+        void OnAdd(Entity entity, const T& component) override
+        {
+            if (aSlots.size() <= entity)
+            {
+                aSlots.resize(static_cast<size_t>(entity) + 1);
+            }
+
+            Insert(entity, mKeyFunc(component));
+        }
+
+        void OnRemove(Entity entity) override
+        {
+            Erase(entity);
+            aSlots[entity].dirty = false;
+        }
+
+        void OnChanged(Entity entity) override
+        {
+            Slot& slot = aSlots[entity];
+            if (slot.dirty) return;
+
+            slot.dirty = true;
+            aDirty.push_back(entity);
+        }
+
+        // the keys are kept, the next scene most likely uses the same layers / textures
+        void OnClear() override
+        {
+            for (Bucket& bucket : aBuckets)
+            {
+                bucket.aEntities.clear();
+            }
+
+            aSlots.clear();
+            aDirty.clear();
+        }
+
+    private:
+        struct Bucket
+        {
+            Key key;
+            std::vector<Entity> aEntities;
+        };
+
+        // per entity, indexed by entity id
+        struct Slot
+        {
+            Entity bucket = INVALID_ENTITY;
+            Entity index = 0; // position in the bucket's entity list
+            bool dirty = false;
+        };
+
+        auto LowerBound(const Key& key)
+        {
+            return std::lower_bound(aBuckets.begin(), aBuckets.end(), key,
+                [](const Bucket& bucket, const Key& k) { return bucket.key < k; });
+        }
+
+        void Insert(Entity entity, const Key& key)
+        {
+            auto it = LowerBound(key);
+            Entity bucket = static_cast<Entity>(it - aBuckets.begin());
+
+            if (it == aBuckets.end() || !(it->key == key))
+            {
+                // a new key shifts the buckets after it, rare for layers and textures
+                aBuckets.insert(it, Bucket{ key, {} });
+
+                for (size_t b = static_cast<size_t>(bucket) + 1; b < aBuckets.size(); ++b)
+                {
+                    for (Entity moved : aBuckets[b].aEntities)
+                    {
+                        aSlots[moved].bucket = static_cast<Entity>(b);
+                    }
+                }
+            }
+
+            std::vector<Entity>& entities = aBuckets[bucket].aEntities;
+            aSlots[entity].bucket = bucket;
+            aSlots[entity].index = static_cast<Entity>(entities.size());
+            entities.push_back(entity);
+        }
+
+        // swap-removes the entity from its bucket
+        void Erase(Entity entity)
+        {
+            Slot& slot = aSlots[entity];
+            std::vector<Entity>& entities = aBuckets[slot.bucket].aEntities;
+
+            Entity last = entities.back();
+            entities[slot.index] = last;
+            aSlots[last].index = slot.index;
+            entities.pop_back();
+
+            slot.bucket = INVALID_ENTITY;
+        }
+
+        ComponentArray<T>* pPool = nullptr;
+        KeyFunc mKeyFunc = nullptr;
+
+        // sorted by key
+        std::vector<Bucket> aBuckets;
+        std::vector<Slot> aSlots;
+
+        // entities written since the last query, each listed once
+        std::vector<Entity> aDirty;
+
+        inline static const std::vector<Entity> aNoEntities{};
+    };
+}
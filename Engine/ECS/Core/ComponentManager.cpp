@@ -12,7 +12,11 @@
 \brief
 Implements ComponentManager methods for entity destruction and component cloning across all registered component types.
 
-Iterates through all component arrays to remove components when an entity is destroyed or copy components during entity duplication.
+Destroying an entity walks the bits of its signature and only touches the pools it populates, Clear empties every
+pool at once. DefragmentStep walks the pools in registration order and sorts the first one still out of order.
+Cloning iterates through all component arrays to copy components during entity duplication.
+Prefab templates are captured from an entity or read from JSON once, then added back with one batched add per pool.
+Logs the per pool memory usage reported by every component array.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -22,25 +26,144 @@ All rights reserved.
 #include "ComponentManager.hpp"
 #include "Coordinator.hpp"
 
-void Uma_ECS::ComponentManager::EntityDestroyed(Entity entity)
+#include <sstream>
+
+void Uma_ECS::ComponentManager::EntityDestroyed(Entity entity, const Signature& signature)
+{
+    signature.ForEachSetBit([&](size_t type)
+        {
+            assert(type < mNextComponentType && "Error : Component is not registered.");
+
+            aComponentArrays[type]->DestroyEntity(entity);
+        });
+}
+
+void Uma_ECS::ComponentManager::MarkChanged(Entity entity, const Signature& signature)
+{
+    signature.ForEachSetBit([&](size_t type)
+        {
+            assert(type < mNextComponentType && "Error : Component is not registered.");
+
+            aComponentArrays[type]->MarkChanged(entity);
+        });
+}
+
+void Uma_ECS::ComponentManager::Clear()
 {
-    for (auto const& pair : aComponentArrays)
+    for (auto const& componentArray : aComponentArrays)
     {
-        auto const& component = pair.second;
+        componentArray->Clear();
+    }
+}
 
-        component->DestroyEntity(entity);
+bool Uma_ECS::ComponentManager::DefragmentStep(size_t maxMoves)
+{
+    // one pool at a time, the first one still out of order gets the whole step
+    for (auto const& componentArray : aComponentArrays)
+    {
+        if (!componentArray->DefragmentStep(maxMoves)) return false;
     }
+
+    return true;
 }
 
 void Uma_ECS::ComponentManager::CloneEntityComponents(Entity src, Entity dest)
 {
-    for (auto const& pair : aComponentArrays)
+    for (auto const& componentArray : aComponentArrays)
     {
-        auto const& componentArray = pair.second;
-
         if (componentArray->Has(src))
         {
             componentArray->CloneComponent(src, dest);
         }
     }
 }
+
+void Uma_ECS::ComponentManager::CloneEntityComponents(Entity src, const std::vector<Entity>& dests)
+{
+    if (dests.empty()) return;
+
+    for (auto const& componentArray : aComponentArrays)
+    {
+        if (componentArray->Has(src))
+        {
+            componentArray->CloneComponent(src, dests);
+        }
+    }
+}
+
+void Uma_ECS::ComponentManager::AddDefaultComponents(const std::vector<Entity>& entities, const Signature& signature)
+{
+    if (entities.empty()) return;
+
+    signature.ForEachSetBit([&](size_t type)
+        {
+            assert(type < mNextComponentType && "Error : Component is not registered.");
+
+            aComponentArrays[type]->AddDefaultData(entities);
+        });
+}
+
+Uma_ECS::Prefab Uma_ECS::ComponentManager::MakePrefab(Entity entity, const Signature& signature) const
+{
+    Prefab prefab;
+    prefab.signature = signature;
+
+    signature.ForEachSetBit([&](size_t type)
+        {
+            assert(type < mNextComponentType && "Error : Component is not registered.");
+
+            prefab.aComponents.push_back({ static_cast<ComponentType>(type), aComponentArrays[type]->CapturePrefab(entity) });
+        });
+
+    return prefab;
+}
+
+Uma_ECS::Prefab Uma_ECS::ComponentManager::MakePrefab(const rapidjson::Value& comps) const
+{
+    Prefab prefab;
+
+    // the name lookups happen here once instead of on every spawn
+    for (ComponentType type = 0; type < mNextComponentType; ++type)
+    {
+        std::unique_ptr<BasePrefabComponent> value = aComponentArrays[type]->DeserializePrefab(comps);
+        if (!value) continue;
+
+        prefab.signature.set(type);
+        prefab.aComponents.push_back({ type, std::move(value) });
+    }
+
+    return prefab;
+}
+
+void Uma_ECS::ComponentManager::AddPrefabComponents(const std::vector<Entity>& entities, const Prefab& prefab)
+{
+    if (entities.empty()) return;
+
+    for (const Prefab::Component& component : prefab.aComponents)
+    {
+        assert(component.type < mNextComponentType && "Error : Component is not registered.");
+
+        component.value->AddTo(*aComponentArrays[component.type], entities);
+    }
+}
+
+void Uma_ECS::ComponentManager::LogMemoryReport() const
+{
+    size_t totalBytes = 0;
+
+    for (auto const& [name, type] : aComponentTypes)
+    {
+        PoolMemoryReport report = aComponentArrays[type]->GetMemoryReport();
+        totalBytes += report.TotalBytes();
+
+        std::stringstream ss;
+        ss << "Component pool " << name << " : " << report.componentCount << " components, "
+            << report.denseBytes << " dense bytes (capacity " << report.denseCapacity << "), "
+            << report.sparseBytes << " sparse bytes (" << report.sparsePages << " pages)";
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+    }
+
+    std::stringstream ss;
+    ss << "Component pools total : " << totalBytes << " bytes";
+    Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+}
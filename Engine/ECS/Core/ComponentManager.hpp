@@ -12,10 +12,14 @@
 \brief
 Manages registration, storage, and retrieval of all component types in the ECS using type-indexed maps.
 
-Maps component type names (via typeid) to unique ComponentType identifiers and corresponding ComponentArray instances.
+Maps ComponentFamily ids to unique ComponentType identifiers, ComponentArray instances are stored in a flat vector
+indexed by ComponentType so per-frame lookups cost two vector indexes. Shared components (SharedComponentArray) are
+registered under the component type Shared<T> and live in the same vector. Type names (via typeid) are kept for serialization.
 Provides template-based API for type-safe component operations (add, remove, get) with compile-time type resolution.
 Handles batch serialization/deserialization of all components for a given entity, returning signatures for deserialized components.
+MakePrefab converts an entity or a prefab's JSON into a Prefab template, AddPrefabComponents copies it into the pools.
 Uses shared pointers for polymorphic component array storage and maintains component type counter for unique identification.
+Owns the world ChangeTick every pool stamps its writes with. SwapBuffers publishes the DoubleBuffered pools.
 Integrates with Uma_Engine debugger for component registration logging.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
@@ -25,10 +29,14 @@ All rights reserved.
 #pragma once
 
 #include "Types.hpp"
+#include "TypeFamily.hpp"
 #include "ComponentArray.hpp"
+#include "SharedComponentArray.hpp"
+#include <vector>
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <utility>
 #include <cassert>
 
 #include <Debugging/Debugger.hpp>
@@ -37,6 +45,9 @@ All rights reserved.
 
 namespace Uma_ECS
 {
+    // marks a component family id that is not registered with this manager
+    const ComponentType INVALID_COMPONENT_TYPE = static_cast<ComponentType>(-1);
+
     class ComponentManager
     {
     public:
@@ -45,41 +56,31 @@ namespace Uma_ECS
         template<typename T>
         void RegisterComponent()
         {
-            std::string type_name = std::string(typeid(T).name());
-
-            // logging
-            std::string debugLog = "Registered component: " + type_name;
-            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, debugLog);
+            auto componentArray = std::make_shared<ComponentArray<T>>();
 
-            // error
-            if (aComponentTypes.find(type_name) != aComponentTypes.end())
+            if constexpr (DoubleBuffered<T>::value)
             {
-                debugLog = "Component<" + type_name + "> being registered more than once. ";
-                Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, debugLog);
+                aDoubleBufferedArrays.push_back(componentArray.get());
             }
 
-            assert(aComponentTypes.find(type_name) == aComponentTypes.end()
-                && "Error : Component being registered more than once.");
-
-
-
-            aComponentTypes.insert({ type_name, mNextComponentType });
-
-            // Use make_shared instead of make_unique
-            aComponentArrays.insert({ type_name, std::make_shared<ComponentArray<T>>() });
+            RegisterArray<T>(std::move(componentArray));
+        }
 
-            ++mNextComponentType;
+        // one value referenced by many entities, registered as the component type Shared<T>
+        template<typename T>
+        void RegisterSharedComponent()
+        {
+            RegisterArray<Shared<T>>(std::make_shared<SharedComponentArray<T>>());
         }
 
         template<typename T>
         ComponentType GetComponentType() 
         {
-            std::string type_name = std::string(typeid(T).name());
+            size_t family = ComponentFamily::GetId<T>();
 
-            assert(aComponentTypes.find(type_name) != aComponentTypes.end()
-                && "Error : Component is not registered.");
+            assert(IsRegistered(family) && "Error : Component is not registered.");
 
-            return aComponentTypes[type_name];
+            return aFamilyToType[family];
         }
 
         ComponentType GetComponentType(const std::string& compType)
@@ -97,6 +98,14 @@ namespace Uma_ECS
             component_array.AddData(entity, component);
         }
 
+        // constructs the component in the pool from args, moves when args is a T rvalue
+        template<typename T, typename... Args>
+        void EmplaceComponent(Entity entity, Args&&... args)
+        {
+            ComponentArray<T>& component_array = GetComponentArray<T>();
+            component_array.EmplaceData(entity, std::forward<Args>(args)...);
+        }
+
         template<typename T>
         void RemoveComponent(Entity entity) 
         {
@@ -114,38 +123,98 @@ namespace Uma_ECS
         template<typename T>
         ComponentArray<T>& GetComponentArray()
         {
-            std::string type_name = std::string(typeid(T).name());
+            static_assert(!IsShared<T>, "Error : Use GetSharedComponentArray for shared components.");
 
-            assert(aComponentTypes.find(type_name) != aComponentTypes.end()
-                && "Error : Component is not registered before.");
+            // flat index, no allocation and no hashing
+            return *static_cast<ComponentArray<T>*>(aComponentArrays[GetComponentType<T>()].get());
+        }
+
+        template<typename T>
+        SharedComponentArray<T>& GetSharedComponentArray()
+        {
+            return *static_cast<SharedComponentArray<T>*>(aComponentArrays[GetComponentType<Shared<T>>()].get());
+        }
 
-            // Use static_pointer_cast to get the derived type back
-            return *std::static_pointer_cast<ComponentArray<T>>(aComponentArrays[type_name]);
+        // pool of T (or of a Shared<T>) through the base interface, for filters that only ask Has / ChangedSince
+        template<typename T>
+        BaseComponentArray& GetBaseComponentArray()
+        {
+            return *aComponentArrays[GetComponentType<T>()];
         }
 
-        void EntityDestroyed(Entity entity);
+        // only the pools in the entity's signature are touched
+        void EntityDestroyed(Entity entity, const Signature& signature);
+
+        // stamps every component in the signature with the current tick
+        void MarkChanged(Entity entity, const Signature& signature);
+
+        // empties every pool, O(pools) for trivially destructible components
+        void Clear();
+
+        // publishes the current state of every double buffered pool, see ComponentArray::SwapBuffers
+        void SwapBuffers()
+        {
+            for (BaseComponentArray* componentArray : aDoubleBufferedArrays)
+            {
+                componentArray->SwapBuffers();
+            }
+        }
+
+        // moves the pools towards ascending entity order, at most maxMoves swaps, true once every pool is in order
+        bool DefragmentStep(size_t maxMoves);
 
         void CloneEntityComponents(Entity src, Entity dest);
 
+        // copies every component of src to all the dests, one batched add per pool
+        void CloneEntityComponents(Entity src, const std::vector<Entity>& dests);
+
+        // adds a default constructed component of every type in signature to all the entities
+        void AddDefaultComponents(const std::vector<Entity>& entities, const Signature& signature);
+
+        // template holding a copy of every component of entity
+        Prefab MakePrefab(Entity entity, const Signature& signature) const;
+
+        // template read from the "components" object of a prefab / scene entity, parsed once
+        Prefab MakePrefab(const rapidjson::Value& comps) const;
+
+        // adds every component of the prefab to all the entities, one batched add per pool
+        void AddPrefabComponents(const std::vector<Entity>& entities, const Prefab& prefab);
+
+        // every pool stamps its adds and tracked writes with this tick
+        inline ChangeTick GetChangeTick() const { return mChangeTick; }
+
+        // returns the tick that was current and moves on to the next one
+        inline ChangeTick AdvanceChangeTick() { return mChangeTick++; }
+
+        // memory used by the pool of one component type
+        PoolMemoryReport GetMemoryReport(ComponentType type) const
+        {
+            assert(type < mNextComponentType && "Error : Component is not registered.");
+
+            return aComponentArrays[type]->GetMemoryReport();
+        }
+
+        // logs the memory report of every pool and the total
+        void LogMemoryReport() const;
+
         void SerializeAll(Entity entity, rapidjson::Value& comps, rapidjson::Document::AllocatorType& allocator) 
         {
-            for (auto const& pair : aComponentArrays) 
+            for (auto const& componentArray : aComponentArrays) 
             {
-                pair.second->Serialize(entity, comps, allocator);
+                componentArray->Serialize(entity, comps, allocator);
             }
         }
 
         Signature DeserializeAll(Entity entity, const rapidjson::Value& comps) 
         {
             Signature sign;
-            for (auto const& pair : aComponentArrays) 
+            for (ComponentType type = 0; type < mNextComponentType; ++type) 
             {
-                std::string compType = pair.second->Deserialize(entity, comps); // ""
+                std::string compType = aComponentArrays[type]->Deserialize(entity, comps); // ""
 
                 if (!compType.empty())
                 {
-                    ComponentType typeIndex = GetComponentType(compType); // returns int
-                    sign.set(typeIndex);  // << set the bit
+                    sign.set(type);  // << set the bit
                 }
             }
             return sign;
@@ -153,11 +222,63 @@ namespace Uma_ECS
 
     private:
 
-        // Unordered map that maps the name of the component to ComponentType
+        // registers the pool under the component type of Key
+        template<typename Key>
+        void RegisterArray(std::shared_ptr<BaseComponentArray> componentArray)
+        {
+            std::string type_name = std::string(typeid(Key).name());
+            size_t family = ComponentFamily::GetId<Key>();
+
+            // logging
+            std::string debugLog = "Registered component: " + type_name;
+            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, debugLog);
+
+            // error
+            if (IsRegistered(family))
+            {
+                debugLog = "Component<" + type_name + "> being registered more than once. ";
+                Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, debugLog);
+            }
+
+            assert(!IsRegistered(family) && "Error : Component being registered more than once.");
+            assert(mNextComponentType < MAX_COMPONENTS && "Error : Too many component types registered.");
+
+            if (aFamilyToType.size() <= family)
+            {
+                aFamilyToType.resize(family + 1, INVALID_COMPONENT_TYPE);
+            }
+            aFamilyToType[family] = mNextComponentType;
+
+            // names are only needed for serialization, never on the per frame path
+            aComponentTypes.insert({ type_name, mNextComponentType });
+
+            // component arrays are indexed by ComponentType
+            aComponentArrays.push_back(std::move(componentArray));
+            aComponentArrays.back()->SetTickSource(&mChangeTick);
+
+            ++mNextComponentType;
+        }
+
+        inline bool IsRegistered(size_t family) const
+        {
+            return family < aFamilyToType.size() && aFamilyToType[family] != INVALID_COMPONENT_TYPE;
+        }
+
+        // ComponentFamily id -> ComponentType of this manager
+        std::vector<ComponentType> aFamilyToType{};
+
+        // Unordered map that maps the name of the component to ComponentType (serialization only)
         std::unordered_map<std::string, ComponentType> aComponentTypes{};
 
-        std::unordered_map<std::string, std::shared_ptr<BaseComponentArray>> aComponentArrays{};
+        // indexed by ComponentType, in registration order
+        std::vector<std::shared_ptr<BaseComponentArray>> aComponentArrays{};
+
+        // pools of the DoubleBuffered components, owned by aComponentArrays
+        std::vector<BaseComponentArray*> aDoubleBufferedArrays{};
 
         ComponentType mNextComponentType{};
+
+        // starts at 1 so everything added before a system's first run counts as changed since 0
+        ChangeTick mChangeTick = 1;
     };
 }
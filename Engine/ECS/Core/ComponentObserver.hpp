@@ -0,0 +1,180 @@
+/*!
+\file   ComponentObserver.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements ComponentObserver, typed OnAdd / OnRemove / OnChange hooks on one component pool, for systems keeping
+derived data (broadphase, render caches, ...) up to date without polling every entity each frame.
+
+The observer is owned by the ComponentArray it observes and only records what happened, one state byte per entity
+and a packed list of the touched entities, no allocation or event per notification. The Coordinator delivers the
+batch at the FlushCommands sync point, every kind of notification in its own contiguous list in the order clear,
+removed, added, changed. Notifications of the same batch are folded together: a component added then removed is
+never reported, a change of a component added in the batch is reported as the add only, an entity whose component
+was removed then added again (recycled id) is reported in both lists.
+Tracked writes (GetMutable / MarkChanged) count as changes, writes through GetData / a view need a MarkChanged.
+The components present when the observer is created are reported as added at the first delivery.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include "ComponentArray.hpp"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace Uma_ECS
+{
+    // type erased side of an observer, the Coordinator delivers every observer at the sync point
+    class IComponentObserver
+    {
+    public:
+        virtual ~IComponentObserver() = default;
+
+        // hands the recorded batch to the callbacks and starts a new one
+        virtual void Deliver() = 0;
+    };
+
+    template<typename T>
+    class ComponentObserver : public ComponentListener<T>, public IComponentObserver
+    {
+    public:
+        using EntityCallback = std::function<void(const std::vector<Entity>&)>;
+        using ClearCallback = std::function<void()>;
+
+        // entities that got the component during the batch
+        ComponentObserver& OnAdd(EntityCallback callback) { mOnAdd = std::move(callback); return *this; }
+
+        // entities that lost the component during the batch, the component is already gone
+        ComponentObserver& OnRemove(EntityCallback callback) { mOnRemove = std::move(callback); return *this; }
+
+        // entities whose component was written through a tracked write during the batch
+        // changes are only recorded once a callback is set
+        ComponentObserver& OnChange(EntityCallback callback) { mOnChange = std::move(callback); return *this; }
+
+        // the pool was emptied (ClearWorld), delivered before the lists of the same batch
+        ComponentObserver& OnClear(ClearCallback callback) { mOnClear = std::move(callback); return *this; }
+
+        // entities with a notification waiting for the next delivery
+        inline size_t PendingCount() const { return aPending.size(); }
+
+        void Deliver() override
+        {
+            bool cleared = mCleared;
+            mCleared = false;
+
+            aAdded.clear();
+            aRemoved.clear();
+            aChanged.clear();
+
+            for (Entity entity : aPending)
+            {
+                uint8_t state = aStates[entity];
+                aStates[entity] = 0;
+
+                if (state & REMOVED) aRemoved.push_back(entity);
+                if (state & ADDED) aAdded.push_back(entity);
+                else if (state & CHANGED) aChanged.push_back(entity);
+            }
+
+            aPending.clear();
+
+            // the batch is taken out first, writes made by the callbacks go to the next one
+            if (cleared && mOnClear) mOnClear();
+            if (!aRemoved.empty() && mOnRemove) mOnRemove(aRemoved);
+            if (!aAdded.empty() && mOnAdd) mOnAdd(aAdded);
+            if (!aChanged.empty() && mOnChange) mOnChange(aChanged);
+        }
+
+        void OnAdd(Entity entity, const T&) override
+        {
+            uint8_t& state = Touch(entity);
+
+            // a removal earlier in the batch stays reported, the entity got a new component after it
+            state = static_cast<uint8_t>(PENDING | (state & REMOVED) | ADDED);
+        }
+
+        void OnRemove(Entity entity) override
+        {
+            uint8_t& state = Touch(entity);
+
+            // added and removed in the same batch, nobody saw the component
+            state = static_cast<uint8_t>(PENDING | ((state & ADDED) ? (state & REMOVED) : REMOVED));
+        }
+
+        void OnChanged(Entity entity) override
+        {
+            if (!mOnChange) return;
+
+            uint8_t& state = Touch(entity);
+            state |= CHANGED;
+        }
+
+        // everything recorded so far is replaced by the clear
+        void OnClear() override
+        {
+            for (Entity entity : aPending)
+            {
+                aStates[entity] = 0;
+            }
+
+            aPending.clear();
+            mCleared = true;
+        }
+
+    private:
+        enum : uint8_t
+        {
+            ADDED = 1 << 0,
+            REMOVED = 1 << 1,
+            CHANGED = 1 << 2,
+            PENDING = 1 << 3 // listed in aPending, kept even when the other bits cancel out
+        };
+
+        // state of the entity in this batch, the entity is listed on its first notification
+        uint8_t& Touch(Entity entity)
+        {
+            if (aStates.size() <= entity)
+            {
+                aStates.resize(static_cast<size_t>(entity) + 1, 0);
+            }
+
+            uint8_t& state = aStates[entity];
+            if (!(state & PENDING))
+            {
+                state = PENDING;
+                aPending.push_back(entity);
+            }
+
+            return state;
+        }
+
+        EntityCallback mOnAdd;
+        EntityCallback mOnRemove;
+        EntityCallback mOnChange;
+        ClearCallback mOnClear;
+
+        // per entity, indexed by entity id
+        std::vector<uint8_t> aStates;
+
+        // entities notified since the last delivery, each listed once
+        std::vector<Entity> aPending;
+        bool mCleared = false;
+
+        // delivered lists, reused across batches
+        std::vector<Entity> aAdded;
+        std::vector<Entity> aRemoved;
+        std::vector<Entity> aChanged;
+    };
+}
@@ -13,30 +13,49 @@
 Implements the Coordinator's entity lifecycle management, event emission, and serialization methods.
 
 Coordinates entity creation/destruction across all three managers (Entity, Component, System) and emits corresponding events.
-Handles entity duplication by cloning components and updating system membership.
-Template methods handle component and system operations with automatic signature updates and system membership
-recalculation. Implements ISerializer for JSON-based scene serialization with RapidJSON. Integrates with
-Uma_Engine::EventSystem to emit entity lifecycle events for external observers.
+Creation (single, batched, from a cached prefab template) and destruction update membership and emit one event per
+batch, ClearWorld resets everything at once for scene reloads. Also implements enable/disable, the time budgeted
+Defragment and FlushCommands. Implements ISerializer for JSON-based scene serialization with RapidJSON.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
 */
 
 #include "Coordinator.hpp"
+#include "EntityCommandBuffer.hpp"
 #include "Core/IMGUIEvents.h"
 
 #include "Debugging/Debugger.hpp"
 
 #include <fstream>
+#include <chrono>
 #include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
 
 namespace Uma_ECS
 {
-    void Coordinator::Init(Uma_Engine::EventSystem* eventSystem)
+    // defined here, EntityCommandBuffer is only forward declared in the header
+    Coordinator::Coordinator() = default;
+    Coordinator::~Coordinator() = default;
+
+    void Coordinator::Init(Uma_Engine::EventSystem* eventSystem, StorageMode mode)
     {
         aComponentManager = std::make_unique<ComponentManager>();
         aEntityManager = std::make_unique<EntityManager>();
         aSystemManager = std::make_unique<SystemManager>();
+        aCommandBuffer = std::make_unique<EntityCommandBuffer>(*this);
+        aObservers.clear();
+        aPrefabCache.clear();
+
+        mStorageMode = mode;
+        if (mStorageMode == StorageMode::SM_Archetype)
+        {
+            aArchetypeStorage = std::make_unique<ArchetypeStorage>();
+        }
+        else
+        {
+            aArchetypeStorage.reset();
+        }
 
         pEventSystem = eventSystem;
     }
@@ -45,6 +64,11 @@ namespace Uma_ECS
     {
         Entity en = aEntityManager->CreateEntity();
 
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->CreateEntity(en);
+        }
+
         if (en >= 0) // entity is created
         {
             pEventSystem->Emit<Uma_Engine::EntityCreatedEvent>(en, GetEntityCount());
@@ -58,10 +82,211 @@ namespace Uma_ECS
         return en;
     }
 
+    std::vector<Entity> Coordinator::CreateEntities(size_t count, const Signature& signature)
+    {
+        std::vector<Entity> entities;
+        aEntityManager->CreateEntities(count, entities);
+
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->CreateEntities(entities, signature);
+        }
+        else
+        {
+            aComponentManager->AddDefaultComponents(entities, signature);
+        }
+
+        for (Entity entity : entities)
+        {
+            aEntityManager->SetSignature(entity, signature);
+        }
+        aSystemManager->EntitiesSignatureChanged(entities, signature);
+
+        EntitiesCreated(entities.size());
+
+        return entities;
+    }
+
+    std::vector<Entity> Coordinator::Instantiate(Entity src, size_t count)
+    {
+        assert(aEntityManager->IsEntityActive(src) && "Error : src entity doesn't exist.");
+
+        Signature signature = GetEntitySignature(src);
+
+        std::vector<Entity> entities;
+        aEntityManager->CreateEntities(count, entities);
+
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->CloneEntity(src, entities);
+        }
+        else
+        {
+            aComponentManager->CloneEntityComponents(src, entities);
+        }
+
+        for (Entity entity : entities)
+        {
+            aEntityManager->SetSignature(entity, signature);
+        }
+        aSystemManager->EntitiesSignatureChanged(entities, signature);
+
+        EntitiesCreated(entities.size());
+
+        return entities;
+    }
+
+    std::vector<Entity> Coordinator::Instantiate(const Prefab& prefab, size_t count)
+    {
+        std::vector<Entity> entities = CreatePrefabInstances(prefab, count);
+        PrefabInstancesCreated(entities, prefab.signature);
+
+        return entities;
+    }
+
+    std::vector<Entity> Coordinator::CreatePrefabInstances(const Prefab& prefab, size_t count)
+    {
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Prefabs are only supported in pooled storage mode.");
+
+        std::vector<Entity> entities;
+        aEntityManager->CreateEntities(count, entities);
+
+        aComponentManager->AddPrefabComponents(entities, prefab);
+
+        return entities;
+    }
+
+    void Coordinator::PrefabInstancesCreated(const std::vector<Entity>& entities, const Signature& signature)
+    {
+        for (Entity entity : entities)
+        {
+            aEntityManager->SetSignature(entity, signature);
+        }
+        aSystemManager->EntitiesSignatureChanged(entities, signature);
+
+        EntitiesCreated(entities.size());
+    }
+
+    Prefab Coordinator::MakePrefab(Entity src)
+    {
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Prefabs are only supported in pooled storage mode.");
+        assert(aEntityManager->IsEntityActive(src) && "Error : src entity doesn't exist.");
+
+        return aComponentManager->MakePrefab(src, GetEntitySignature(src));
+    }
+
+    Prefab Coordinator::MakePrefab(const rapidjson::Value& in)
+    {
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Prefabs are only supported in pooled storage mode.");
+
+        if (!in.IsObject() || !in.HasMember("components")) return Prefab{};
+
+        return aComponentManager->MakePrefab(in["components"]);
+    }
+
+    const Prefab* Coordinator::LoadPrefab(const std::string& filename)
+    {
+        auto it = aPrefabCache.find(filename);
+        if (it != aPrefabCache.end()) return &it->second;
+
+        std::ifstream ifs(filename);
+        if (!ifs)
+        {
+            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, "Prefab file not found : " + filename);
+            return nullptr;
+        }
+
+        rapidjson::IStreamWrapper isw(ifs);
+        rapidjson::Document doc;
+        doc.ParseStream(isw);
+        ifs.close();
+
+        if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("Prefab"))
+        {
+            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eError, "Prefab file is not a prefab : " + filename);
+            return nullptr;
+        }
+
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, "Prefab cached : " + filename);
+
+        return &aPrefabCache.emplace(filename, MakePrefab(doc["Prefab"])).first->second;
+    }
+
+    void Coordinator::ClearPrefabCache()
+    {
+        aPrefabCache.clear();
+    }
+
+    void Coordinator::DestroyEntities(const std::vector<Entity>& entities)
+    {
+        if (entities.empty()) return;
+
+        for (Entity entity : entities)
+        {
+            // the pools go first, destroying the id resets the signature that says which pools to touch
+            if (aArchetypeStorage)
+            {
+                aArchetypeStorage->DestroyEntity(entity);
+            }
+            else
+            {
+                aComponentManager->EntityDestroyed(entity, aEntityManager->GetSignature(entity));
+            }
+
+            aEntityManager->DestroyEntity(entity);
+        }
+
+        aSystemManager->EntitiesDestroyed(entities);
+        pEventSystem->Emit<Uma_Engine::EntitiesDestroyedEvent>(static_cast<int>(entities.size()), GetEntityCount());
+
+        std::stringstream ss;
+        ss << "Destroyed Entities : " << entities.size();
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+    }
+
+    EntityCommandBuffer& Coordinator::GetCommandBuffer()
+    {
+        assert(aCommandBuffer && "Error : Coordinator is not initialized.");
+
+        return *aCommandBuffer;
+    }
+
+    void Coordinator::FlushCommands()
+    {
+        GetCommandBuffer().Flush();
+
+        for (IComponentObserver* observer : aObservers)
+        {
+            observer->Deliver();
+        }
+    }
+
+    void Coordinator::EntitiesCreated(size_t count)
+    {
+        if (count == 0) return;
+
+        pEventSystem->Emit<Uma_Engine::EntitiesCreatedEvent>(static_cast<int>(count), GetEntityCount());
+
+        std::stringstream ss;
+        ss << "Created Entities : " << count;
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+    }
+
     void Coordinator::DestroyEntity(Entity entity)
     {
+        assert(aEntityManager->IsEntityActive(entity) && "Error : Attempting to destroy an inactive entity.");
+
+        // only the pools in the signature own a component of this entity
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->DestroyEntity(entity);
+        }
+        else
+        {
+            aComponentManager->EntityDestroyed(entity, aEntityManager->GetSignature(entity));
+        }
+
         aEntityManager->DestroyEntity(entity);
-        aComponentManager->EntityDestroyed(entity);
         aSystemManager->EntityDestroyed(entity);
         pEventSystem->Emit<Uma_Engine::EntityDestroyedEvent>(entity, GetEntityCount());
 
@@ -76,6 +301,16 @@ namespace Uma_ECS
         return aEntityManager->HasActiveEntity(entity);
     }
 
+    EntityHandle Coordinator::GetHandle(Entity entity) const
+    {
+        return aEntityManager->GetHandle(entity);
+    }
+
+    bool Coordinator::IsValid(const EntityHandle& handle) const
+    {
+        return aEntityManager->IsValid(handle);
+    }
+
     Signature Coordinator::GetEntitySignature(Entity entity)
     {
         return aEntityManager->GetSignature(entity);
@@ -86,11 +321,25 @@ namespace Uma_ECS
         return aEntityManager->GetEntityCount();
     }
 
+    void Coordinator::LogMemoryReport() const
+    {
+        aComponentManager->LogMemoryReport();
+    }
+
     Entity Coordinator::DuplicateEntity(Entity src)
     {
         Entity newEntity = CreateEntity();
-        aComponentManager->CloneEntityComponents(src, newEntity);
 
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->CloneEntity(src, newEntity);
+        }
+        else
+        {
+            aComponentManager->CloneEntityComponents(src, newEntity);
+        }
+
+        aEntityManager->SetSignature(newEntity, GetEntitySignature(src));
         aSystemManager->EntitySignatureChanged(newEntity, GetEntitySignature(src));
 
         return newEntity;
@@ -98,31 +347,114 @@ namespace Uma_ECS
 
     void Coordinator::DestroyAllEntities()
     {
-        std::vector<Entity> enList = aEntityManager->GetAllEntites();
+        // recorded commands refer to the entities being destroyed, their ids are about to be reused
+        GetCommandBuffer().Clear();
+
+        // one batch, a single event and log line instead of one per entity
+        DestroyEntities(aEntityManager->GetAllEntites());
+    }
+
+    void Coordinator::SwapBuffers()
+    {
+        if (aArchetypeStorage) return;
 
-        for (auto const& en : enList)
+        aComponentManager->SwapBuffers();
+    }
+
+    bool Coordinator::Defragment(double budgetMs)
+    {
+        // archetype chunks are packed per signature already
+        if (aArchetypeStorage) return true;
+
+        // swaps done between two clock reads
+        const size_t DEFRAGMENT_STEP = 256;
+
+        auto start = std::chrono::steady_clock::now();
+        auto withinBudget = [start, budgetMs]()
+            {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < budgetMs;
+            };
+
+        // the system lists first, they decide the order the pools are walked in
+        while (aSystemManager->SortNextEntityList())
         {
-            DestroyEntity(en);
+            if (!withinBudget()) return false;
         }
 
-        std::string log;
-        std::stringstream ss(log);
-        ss << "Destroyed Entities : " << enList.size();
+        do
+        {
+            if (aComponentManager->DefragmentStep(DEFRAGMENT_STEP)) return true;
+        } while (withinBudget());
+
+        return false;
+    }
+
+    void Coordinator::ClearWorld()
+    {
+        GetCommandBuffer().Clear();
+
+        int destroyedCount = GetEntityCount();
+
+        // every pool, index map and system list is reset as a whole, no entity is visited through the pools
+        aEntityManager->DestroyAllEntities();
+        aSystemManager->AllEntitiesDestroyed();
+
+        if (aArchetypeStorage)
+        {
+            aArchetypeStorage->Clear();
+        }
+        else
+        {
+            aComponentManager->Clear();
+        }
+
+        if (destroyedCount == 0) return;
+
+        pEventSystem->Emit<Uma_Engine::EntitiesDestroyedEvent>(destroyedCount, GetEntityCount());
+
+        std::stringstream ss;
+        ss << "Cleared World : " << destroyedCount << " entities";
         Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
     }
 
+    void Coordinator::SetEnabled(Entity entity, bool enabled)
+    {
+        assert(aEntityManager->IsEntityActive(entity) && "Error : Attempting to enable / disable an inactive entity.");
+
+        if (aEntityManager->IsEnabled(entity) == enabled) return;
+
+        aEntityManager->SetEnabled(entity, enabled);
+
+        // Changed queries skipped the entity while it was disabled, whatever was written meanwhile shows up now
+        if (enabled && !aArchetypeStorage)
+        {
+            aComponentManager->MarkChanged(entity, aEntityManager->GetSignature(entity));
+        }
+    }
+
+    bool Coordinator::IsEnabled(Entity entity) const
+    {
+        return aEntityManager->IsEnabled(entity);
+    }
+
     void Coordinator::Serialize(rapidjson::Value& out, rapidjson::Document::AllocatorType& allocator)
     {
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Serialization is only supported in pooled storage mode.");
+
         out.SetArray();
 
-        // loop thru all entities
-        for (const Entity& en : aEntityManager->GetAllEntites())
+        // loop thru all entities, only the live ones are visited
+        for (const Entity& en : aEntityManager->GetAliveEntities())
         {
-            if (!aEntityManager->IsEntityActive(en)) continue;
-
             rapidjson::Value entityObj(rapidjson::kObjectType);
             entityObj.AddMember("id", en, allocator);
 
+            // only written for disabled entities, older scenes without it load enabled
+            if (!aEntityManager->IsEnabled(en))
+            {
+                entityObj.AddMember("enabled", false, allocator);
+            }
+
             rapidjson::Value comps(rapidjson::kObjectType);
             aComponentManager->SerializeAll(en, comps, allocator);
             entityObj.AddMember("components", comps, allocator);
@@ -134,16 +466,34 @@ namespace Uma_ECS
     void Coordinator::Deserialize(const rapidjson::Value& in)
     {
         assert(in.IsArray());
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Serialization is only supported in pooled storage mode.");
 
-        for (auto& entityVal : in.GetArray())
+        // new IDs for the whole scene in one batch, the systems and listeners only hear of them once they're filled
+        std::vector<Entity> entities;
+        aEntityManager->CreateEntities(in.Size(), entities);
+        std::vector<Signature> signatures;
+        signatures.reserve(entities.size());
+
+        for (size_t i = 0; i < entities.size(); ++i)
         {
-            Entity entity = CreateEntity(); // new ID
-            const auto& comps = entityVal["components"];
+            Entity entity = entities[i];
+            const auto& entityObj = in[static_cast<rapidjson::SizeType>(i)];
+            const auto& comps = entityObj["components"];
             Signature sign = aComponentManager->DeserializeAll(entity, comps);
             aEntityManager->SetSignature(entity, sign);
-            aSystemManager->EntitySignatureChanged(entity, GetEntitySignature(entity));
+
+            if (entityObj.HasMember("enabled") && entityObj["enabled"].IsBool() && !entityObj["enabled"].GetBool())
+            {
+                aEntityManager->SetEnabled(entity, false);
+            }
+
+            signatures.push_back(sign);
         }
 
+        // systems pick up the whole scene in one pass
+        aSystemManager->EntitiesSignatureChanged(entities, signatures);
+
+        EntitiesCreated(entities.size());
     }
 
     void Coordinator::SerializePrefab(Entity entity, rapidjson::Value& out, rapidjson::Document::AllocatorType& allocator)
@@ -161,10 +511,9 @@ namespace Uma_ECS
 
     void Coordinator::DeserializePrefab(const rapidjson::Value& in)
     {
-        Entity entity = CreateEntity(); // new ID
-        const auto& comps = in["components"];
-        Signature sign = aComponentManager->DeserializeAll(entity, comps);
-        aEntityManager->SetSignature(entity, sign);
-        aSystemManager->EntitySignatureChanged(entity, GetEntitySignature(entity));
+        assert(mStorageMode == StorageMode::SM_Pooled && "Error : Serialization is only supported in pooled storage mode.");
+
+        // same path as the cached prefabs, one instance of a template read from in
+        Instantiate(MakePrefab(in), 1);
     }
 }
@@ -26,9 +26,19 @@ All rights reserved.
 #pragma once
 
 #include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Types.hpp"
 #include "ComponentManager.hpp"
+#include "ComponentIndex.hpp"
+#include "ComponentObserver.hpp"
+#include "ArchetypeStorage.hpp"
+#include "View.hpp"
 #include "EntityManager.hpp"
 #include "SystemManager.hpp"
 
@@ -40,6 +50,8 @@ All rights reserved.
 
 namespace Uma_ECS
 {
+    class EntityCommandBuffer;
+
     // this whole Corrdinator context is about combining:
     // Entity Manager, System Manager and Entity Manager 
     // into a single coordinator that can handles everything 
@@ -47,82 +59,495 @@ namespace Uma_ECS
     class Coordinator : public Uma_Engine::ISerializer
     {
     public:
-        void Init(Uma_Engine::EventSystem* eventSystem);
+        Coordinator();
+        ~Coordinator();
+
+        // mode picks where the component data lives, per-type ComponentArrays (default) or ArchetypeStorage chunks
+        void Init(Uma_Engine::EventSystem* eventSystem, StorageMode mode = StorageMode::SM_Pooled);
+
+        inline StorageMode GetStorageMode() const { return mStorageMode; }
 
         // Entity functions
 
         Entity CreateEntity();
 
+        // creates count entities that own a default constructed component of every type in signature
+        // pools grow once, membership is updated once and a single EntitiesCreatedEvent is sent
+        std::vector<Entity> CreateEntities(size_t count, const Signature& signature = Signature{});
+
+        // creates count copies of src, batched like CreateEntities
+        std::vector<Entity> Instantiate(Entity src, size_t count);
+
+        // creates count instances of prefab, batched like CreateEntities (pooled storage mode)
+        std::vector<Entity> Instantiate(const Prefab& prefab, size_t count);
+
+        // same, override(index, entity) runs on every instance before the systems pick up the batch
+        // coordinator.Instantiate(enemy, 100, [&](size_t i, Entity e) { coordinator.GetComponent<Transform>(e).position = spawns[i]; });
+        template<typename Override>
+        std::vector<Entity> Instantiate(const Prefab& prefab, size_t count, Override&& override)
+        {
+            std::vector<Entity> entities = CreatePrefabInstances(prefab, count);
+
+            for (size_t i = 0; i < entities.size(); ++i)
+            {
+                override(i, entities[i]);
+            }
+
+            PrefabInstancesCreated(entities, prefab.signature);
+            return entities;
+        }
+
+        // Prefabs (pooled storage mode)
+
+        // template holding a copy of every component of src, src can be destroyed afterwards
+        Prefab MakePrefab(Entity src);
+
+        // template read from a prefab JSON object ({ "components": { ... } }), the name lookups are done once here
+        Prefab MakePrefab(const rapidjson::Value& in);
+
+        // prefab file converted once, later calls with the same filename return the cached template
+        // nullptr if the file can't be read
+        const Prefab* LoadPrefab(const std::string& filename);
+
+        // drops the cached templates, the next LoadPrefab reads the files again
+        void ClearPrefabCache();
+
         void DestroyEntity(Entity entity);
 
         bool HasActiveEntity(Entity entity) const;
 
+        // handle that can be kept across frames, IsValid rejects it once the entity is destroyed
+        EntityHandle GetHandle(Entity entity) const;
+        bool IsValid(const EntityHandle& handle) const;
+
         Signature GetEntitySignature(Entity entity);
 
         int GetEntityCount() const;
 
+        // destroys every entity as one batch, one EntitiesDestroyedEvent
         void DestroyAllEntities();
 
+        // scene reload, resets every pool, the entity records and the system lists without visiting the entities
+        // systems, registered components and outstanding EntityHandles (which become invalid) are kept
+        void ClearWorld();
+
+        // a disabled entity keeps its components, signature and system membership, views and ForEach skip it
+        // not a structural change, no event and no pool is touched, so pooled entities (projectiles, effects) can be
+        // parked and reused instead of destroyed and recreated
+        void SetEnabled(Entity entity, bool enabled);
+        bool IsEnabled(Entity entity) const;
+
+        // incremental defragmenter, sorts the system entity lists and the component pools back into ascending entity
+        // order after churn so systems walk every pool front to back, stops once budgetMs is spent
+        // true when everything is in order, call it at a sync point (no view / ForEach in progress)
+        bool Defragment(double budgetMs);
+
+        // end of frame sync point for the DoubleBuffered components (Transform), their current state becomes the
+        // read-only previous buffer that rendering / AI read through ComponentArray::GetPrevious
+        // while the next frame's writers run, nothing to do in archetype storage mode
+        void SwapBuffers();
+
         // Components functions
 
         template<typename T>
         void RegisterComponent() 
         {
             aComponentManager->RegisterComponent<T>();
+
+            if (aArchetypeStorage)
+            {
+                aArchetypeStorage->RegisterComponent<T>(aComponentManager->GetComponentType<T>());
+            }
         }
 
         template<typename T>
         void AddComponent(Entity entity, const T& component) 
+        {
+            EmplaceComponent<T>(entity, component);
+        }
+
+        // the component is moved into the storage, its heap memory (shapes, names, ...) is handed over
+        template<typename T> requires (!std::is_lvalue_reference_v<T>)
+        void AddComponent(Entity entity, T&& component)
+        {
+            EmplaceComponent<T>(entity, std::move(component));
+        }
+
+        // constructs the component in place from args
+        // coordinator.EmplaceComponent<Sprite>(entity, Sprite{ .textureName = "player" });
+        template<typename T, typename... Args>
+        void EmplaceComponent(Entity entity, Args&&... args)
         {
             // add component
-            aComponentManager->AddComponent<T>(entity, component);
+            EmplaceComponentData<T>(entity, std::forward<Args>(args)...);
 
             // get curr signature of the entity 
             // set the bitset of the component to true
             // update the entity manager and system manager
+            ComponentType type = aComponentManager->GetComponentType<T>();
+
             auto signature = aEntityManager->GetSignature(entity);
-            signature.set(aComponentManager->GetComponentType<T>(), true);
+            signature.set(type, true);
 
             aEntityManager->SetSignature(entity, signature);
 
+            // only the systems requiring T are re-checked
+            aSystemManager->EntityComponentChanged(entity, type, signature);
+        }
+
+        // adds every component to the entity, the systems are re-checked once at the end
+        // rvalue components are moved in, lvalues are copied
+        // coordinator.AddComponents(entity, Transform{}, RigidBody{}, Sprite{});
+        template<typename... Ts>
+        void AddComponents(Entity entity, Ts&&... components)
+        {
+            static_assert(sizeof...(Ts) > 0, "Error : AddComponents needs at least one component.");
+
+            (EmplaceComponentData<std::decay_t<Ts>>(entity, std::forward<Ts>(components)), ...);
+
+            auto signature = aEntityManager->GetSignature(entity);
+            (signature.set(aComponentManager->GetComponentType<std::decay_t<Ts>>(), true), ...);
+
+            aEntityManager->SetSignature(entity, signature);
             aSystemManager->EntitySignatureChanged(entity, signature);
         }
 
+        // adds a copy of component to every entity, the pool grows once
+        template<typename T>
+        void AddComponents(const std::vector<Entity>& entities, const T& component)
+        {
+            ComponentType type = aComponentManager->GetComponentType<T>();
+
+            if (aArchetypeStorage)
+            {
+                for (Entity entity : entities)
+                {
+                    aArchetypeStorage->AddComponent<T>(entity, type, component);
+                }
+            }
+            else
+            {
+                aComponentManager->GetComponentArray<T>().AddData(entities, component);
+            }
+
+            std::vector<Signature> signatures;
+            signatures.reserve(entities.size());
+
+            for (Entity entity : entities)
+            {
+                auto signature = aEntityManager->GetSignature(entity);
+                signature.set(type, true);
+
+                aEntityManager->SetSignature(entity, signature);
+                signatures.push_back(signature);
+            }
+
+            // only the systems requiring T are re-checked, once for the whole batch
+            aSystemManager->EntitiesComponentChanged(entities, type, signatures);
+        }
+
         template<typename T>
-        void RemoveComponent(Entity entity, const T& component)
+        void RemoveComponent(Entity entity)
         {
             // remove component
-            aComponentManager->RemoveComponent<T>(entity, component);
+            RemoveComponentData<T>(entity);
 
             // get curr signature of the entity 
             // set the bitset of the component to false
             // update the entity manager and system manager
+            ComponentType type = aComponentManager->GetComponentType<T>();
+
             auto signature = aEntityManager->GetSignature(entity);
-            signature.set(aComponentManager->GetComponentType<T>(), false);
+            signature.set(type, false);
 
             aEntityManager->SetSignature(entity, signature);
 
-            aSystemManager->EntitySignatureChanged(entity, signature);
+            // only the systems requiring T are re-checked
+            aSystemManager->EntityComponentChanged(entity, type, signature);
         }
 
+        // mutable accessor, the component is stamped as changed (pooled storage mode)
         template<typename T>
         T& GetComponent(Entity entity)
         {
-            return aComponentManager->GetComponent<T>(entity);
+            if (aArchetypeStorage)
+            {
+                return aArchetypeStorage->GetComponent<T>(entity, aComponentManager->GetComponentType<T>());
+            }
+
+            return aComponentManager->GetComponentArray<T>().GetMutable(entity);
+        }
+
+        // read only accessor, nothing is stamped, so views / indexes / observers never hear about it
+        template<typename T>
+        const T& ReadComponent(Entity entity)
+        {
+            if (aArchetypeStorage)
+            {
+                return aArchetypeStorage->GetComponent<T>(entity, aComponentManager->GetComponentType<T>());
+            }
+
+            return aComponentManager->GetComponentArray<T>().GetData(entity);
+        }
+
+        template<typename T>
+        bool HasComponent(Entity entity)
+        {
+            if (aArchetypeStorage)
+            {
+                return aArchetypeStorage->Has(entity, aComponentManager->GetComponentType<T>());
+            }
+
+            return aComponentManager->GetComponentArray<T>().Has(entity);
         }
 
+        // only valid in pooled storage mode, archetype mode has no per-type array
         template<typename T>
         ComponentArray<T>& GetComponentArray()
         {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Component arrays are only available in pooled storage mode.");
+
             return aComponentManager->GetComponentArray<T>();
         }
 
+        // Secondary indexes (pooled storage mode)
+
+        // groups the entities owning T by the key extract returns, kept up to date on add / remove / tracked writes
+        // extract is a function or a lambda without captures
+        // auto& byLayer = coordinator.CreateIndex<Sprite>([](const Sprite& sr) { return sr.renderLayer; });
+        template<typename T, typename Extract>
+        auto& CreateIndex(Extract extract)
+        {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Component indexes are only available in pooled storage mode.");
+
+            using Key = std::decay_t<std::invoke_result_t<Extract, const T&>>;
+            typename ComponentIndex<T, Key>::KeyFunc keyFunc = extract;
+
+            ComponentArray<T>& pool = aComponentManager->GetComponentArray<T>();
+            return pool.AddListener(std::make_unique<ComponentIndex<T, Key>>(pool, keyFunc));
+        }
+
+        // Observers (pooled storage mode)
+
+        // records the adds / removes / tracked writes of T, delivered in one batch per kind at FlushCommands
+        // coordinator.Observe<Collider>().OnAdd([this](const std::vector<Entity>& added) { ... });
+        template<typename T>
+        ComponentObserver<T>& Observe()
+        {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Component observers are only available in pooled storage mode.");
+
+            ComponentArray<T>& pool = aComponentManager->GetComponentArray<T>();
+            ComponentObserver<T>& observer = pool.AddListener(std::make_unique<ComponentObserver<T>>());
+
+            aObservers.push_back(&observer);
+            return observer;
+        }
+
+        // Shared components (pooled storage mode)
+
+        // one value referenced by many entities, the pool groups the entities by value
+        // the component type is Shared<T>, so an entity can own T and Shared<T> independently
+        template<typename T>
+        void RegisterSharedComponent()
+        {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Shared components are only available in pooled storage mode.");
+
+            aComponentManager->RegisterSharedComponent<T>();
+        }
+
+        // the entity references the group holding value, an entity that already has one moves to the new group
+        // coordinator.SetSharedComponent(wall, Sprite{ .textureName = "wall_top", .renderLayer = RL_WALL });
+        template<typename T>
+        void SetSharedComponent(Entity entity, const T& value)
+        {
+            SharedComponentArray<T>& pool = aComponentManager->GetSharedComponentArray<T>();
+
+            if (pool.Has(entity))
+            {
+                pool.SetData(entity, value);
+                return;
+            }
+
+            pool.AddData(entity, value);
+
+            ComponentType type = aComponentManager->GetComponentType<Shared<T>>();
+
+            auto signature = aEntityManager->GetSignature(entity);
+            signature.set(type, true);
+
+            aEntityManager->SetSignature(entity, signature);
+            aSystemManager->EntityComponentChanged(entity, type, signature);
+        }
+
+        // every entity joins the group holding value, the systems are re-checked once for the batch
+        template<typename T>
+        void SetSharedComponents(const std::vector<Entity>& entities, const T& value)
+        {
+            ComponentType type = aComponentManager->GetComponentType<Shared<T>>();
+            aComponentManager->GetSharedComponentArray<T>().AddData(entities, value);
+
+            std::vector<Signature> signatures;
+            signatures.reserve(entities.size());
+
+            for (Entity entity : entities)
+            {
+                auto signature = aEntityManager->GetSignature(entity);
+                signature.set(type, true);
+
+                aEntityManager->SetSignature(entity, signature);
+                signatures.push_back(signature);
+            }
+
+            aSystemManager->EntitiesComponentChanged(entities, type, signatures);
+        }
+
+        // read only, the value is shared by the whole group, change it with SetSharedComponent
+        template<typename T>
+        const T& GetSharedComponent(Entity entity)
+        {
+            return aComponentManager->GetSharedComponentArray<T>().GetData(entity);
+        }
+
+        template<typename T>
+        bool HasSharedComponent(Entity entity)
+        {
+            return aComponentManager->GetSharedComponentArray<T>().Has(entity);
+        }
+
+        template<typename T>
+        void RemoveSharedComponent(Entity entity)
+        {
+            aComponentManager->GetSharedComponentArray<T>().RemoveData(entity);
+
+            ComponentType type = aComponentManager->GetComponentType<Shared<T>>();
+
+            auto signature = aEntityManager->GetSignature(entity);
+            signature.set(type, false);
+
+            aEntityManager->SetSignature(entity, signature);
+            aSystemManager->EntityComponentChanged(entity, type, signature);
+        }
+
+        // groups of T, eg. to draw one batch per distinct sprite
+        template<typename T>
+        SharedComponentArray<T>& GetSharedComponentArray()
+        {
+            return aComponentManager->GetSharedComponentArray<T>();
+        }
+
+        // calls func(Entity, T&, Ts&...) for every enabled entity that has all the components
+        // archetype mode walks the chunks linearly, pooled mode walks the first pool and looks the rest up
+        template<typename T, typename... Ts, typename Func>
+        void ForEach(Func&& func)
+        {
+            const EntityManager& entities = *aEntityManager;
+            bool anyDisabled = entities.GetDisabledCount() > 0;
+
+            if (aArchetypeStorage)
+            {
+                if (!anyDisabled)
+                {
+                    aArchetypeStorage->ForEach<T, Ts...>(
+                        { aComponentManager->GetComponentType<T>(), aComponentManager->GetComponentType<Ts>()... }, func);
+                    return;
+                }
+
+                aArchetypeStorage->ForEach<T, Ts...>(
+                    { aComponentManager->GetComponentType<T>(), aComponentManager->GetComponentType<Ts>()... },
+                    [&entities, &func](Entity entity, T& component, Ts&... components)
+                    {
+                        if (entities.IsEnabled(entity)) func(entity, component, components...);
+                    });
+                return;
+            }
+
+            ComponentArray<T>& first = aComponentManager->GetComponentArray<T>();
+            auto others = std::tie(aComponentManager->GetComponentArray<Ts>()...);
+
+            std::apply([&first, &func, &entities, anyDisabled](auto&... arrays)
+                {
+                    for (size_t i = 0; i < first.Size(); ++i)
+                    {
+                        Entity entity = first.GetEntity(i);
+
+                        if (anyDisabled && !entities.IsEnabled(entity)) continue;
+
+                        if (!(arrays.Has(entity) && ...)) continue;
+
+                        func(entity, first.GetComponentAt(i), arrays.GetData(entity)...);
+                    }
+                }, others);
+        }
+
+        // query over the component pools, iterates the smallest pool of Ts and skips disabled entities and the ones
+        // owning any of Es
+        // for (auto [entity, tf, rb] : coordinator.View<Transform, RigidBody>(Exclude<Enemy>{})) { ... }
+        template<typename... Ts, typename... Es>
+        ComponentView<Ts...> View(Exclude<Es...> = {})
+        {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Views are only available in pooled storage mode, use ForEach.");
+
+            return ComponentView<Ts...>(
+                std::make_tuple(&aComponentManager->GetComponentArray<Ts>()...),
+                std::vector<const BaseComponentArray*>{ &aComponentManager->GetBaseComponentArray<Es>()... },
+                DisabledFlags());
+        }
+
+        // same query, only yields the entities where one of Cs was added / written after changed.since
+        // for (auto [entity, c, tf] : coordinator.View<Collider, Transform>(Changed<Collider, Transform>{ mLastTick })) { ... }
+        template<typename... Ts, typename... Cs, typename... Es>
+        ComponentView<Ts...> View(Changed<Cs...> changed, Exclude<Es...> = {})
+        {
+            assert(mStorageMode == StorageMode::SM_Pooled && "Error : Views are only available in pooled storage mode, use ForEach.");
+
+            typename ComponentView<Ts...>::ChangeFilter filter;
+            filter.active = true;
+            filter.since = changed.since;
+            filter.aTracked = { IsOneOf<Ts, Cs...>... };
+
+            // the Cs that aren't viewed are checked through their base pool
+            ((IsOneOf<Cs, Ts...> ? void() : filter.aOthers.push_back(&aComponentManager->GetBaseComponentArray<Cs>())), ...);
+
+            return ComponentView<Ts...>(
+                std::make_tuple(&aComponentManager->GetComponentArray<Ts>()...),
+                std::vector<const BaseComponentArray*>{ &aComponentManager->GetBaseComponentArray<Es>()... },
+                DisabledFlags(), std::move(filter));
+        }
+
+        // Change tracking (pooled storage mode)
+
+        // current world tick, adds and tracked writes are stamped with it
+        inline ChangeTick GetChangeTick() const { return aComponentManager->GetChangeTick(); }
+
+        // a system calls this when it runs and keeps the result as the since of its next Changed query
+        // returns the tick that was current, writes from now on are stamped with a later one
+        inline ChangeTick AdvanceChangeTick() { return aComponentManager->AdvanceChangeTick(); }
+
+        // stamps a component written through a view or GetComponentArray().GetData
+        template<typename T>
+        void MarkChanged(Entity entity)
+        {
+            if (aArchetypeStorage) return;
+
+            aComponentManager->GetComponentArray<T>().MarkChanged(entity);
+        }
+
         template<typename T>
         ComponentType GetComponentType()
         {
             return aComponentManager->GetComponentType<T>();
         }
 
+        // memory used by the pool of T (pooled storage mode)
+        template<typename T>
+        PoolMemoryReport GetComponentMemoryReport() const
+        {
+            return aComponentManager->GetMemoryReport(aComponentManager->GetComponentType<T>());
+        }
+
+        // logs the memory used by every component pool
+        void LogMemoryReport() const;
+
         // System functions
 
         template<typename T>
@@ -139,6 +564,14 @@ namespace Uma_ECS
 
         Entity DuplicateEntity(Entity src);
 
+        // Deferred structural changes
+
+        // commands recorded here are applied by FlushCommands, safe to record while systems iterate
+        EntityCommandBuffer& GetCommandBuffer();
+
+        // sync point, applies everything recorded in the command buffer then delivers the observers
+        void FlushCommands();
+
         //Serialization
 
         //void SerializeAllEntities(const std::string& filename);
@@ -152,6 +585,54 @@ namespace Uma_ECS
         void DeserializePrefab(const rapidjson::Value& in) override;
 
     private:
+        // the command buffer applies its commands through the storage-only helpers below
+        friend class EntityCommandBuffer;
+
+        // stores the component without touching the signature or the systems
+        template<typename T, typename... Args>
+        void EmplaceComponentData(Entity entity, Args&&... args)
+        {
+            if (aArchetypeStorage)
+            {
+                aArchetypeStorage->EmplaceComponent<T>(entity, aComponentManager->GetComponentType<T>(), std::forward<Args>(args)...);
+            }
+            else
+            {
+                aComponentManager->EmplaceComponent<T>(entity, std::forward<Args>(args)...);
+            }
+        }
+
+        template<typename T>
+        void RemoveComponentData(Entity entity)
+        {
+            if (aArchetypeStorage)
+            {
+                aArchetypeStorage->RemoveComponent<T>(entity, aComponentManager->GetComponentType<T>());
+            }
+            else
+            {
+                aComponentManager->RemoveComponent<T>(entity);
+            }
+        }
+
+        // destroys a batch, the systems are updated once and one EntitiesDestroyedEvent is sent
+        void DestroyEntities(const std::vector<Entity>& entities);
+
+        // new entities owning the components of prefab, not yet given a signature or seen by the systems
+        std::vector<Entity> CreatePrefabInstances(const Prefab& prefab, size_t count);
+
+        // signatures, system membership and the summary event of a prefab batch
+        void PrefabInstancesCreated(const std::vector<Entity>& entities, const Signature& signature);
+
+        // summary log and event of a batch made by CreateEntities / Instantiate / Deserialize
+        void EntitiesCreated(size_t count);
+
+        // flags handed to the views, nullptr keeps the per entity test out of the loop while nothing is disabled
+        inline const std::vector<uint8_t>* DisabledFlags() const
+        {
+            return aEntityManager->GetDisabledCount() > 0 ? &aEntityManager->GetDisabledFlags() : nullptr;
+        }
+
         std::unique_ptr<ComponentManager> aComponentManager;
         std::unique_ptr<EntityManager> aEntityManager;
 
@@ -160,6 +641,18 @@ namespace Uma_ECS
         // thr are changes for any entities
         std::unique_ptr<SystemManager> aSystemManager;
 
+        // only created in archetype storage mode
+        std::unique_ptr<ArchetypeStorage> aArchetypeStorage;
+        StorageMode mStorageMode = StorageMode::SM_Pooled;
+
+        std::unique_ptr<EntityCommandBuffer> aCommandBuffer;
+
+        // templates converted by LoadPrefab, keyed by filename
+        std::unordered_map<std::string, Prefab> aPrefabCache;
+
+        // owned by their pools, delivered in creation order
+        std::vector<IComponentObserver*> aObservers;
+
         Uma_Engine::EventSystem* pEventSystem = nullptr;
     };
 }
@@ -0,0 +1,223 @@
+/*!
+\file   EntityCommandBuffer.cpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements the recording of entity commands and the sorted, merged flush of EntityCommandBuffer.
+
+Flush creates the surviving pending entities in one batch, resolves the pending ids, drops commands on entities
+that no longer exist and stable sorts the rest by entity so each entity's commands are merged in recording order.
+Destroys are applied as one batch and the signatures of all touched entities are pushed to the systems in one pass.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#include "EntityCommandBuffer.hpp"
+
+#include <algorithm>
+
+namespace Uma_ECS
+{
+    Entity EntityCommandBuffer::CreateEntity()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        assert(mPendingCount < PENDING_ENTITY_FLAG - 1 && "Error : Too many pending entities.");
+
+        return PENDING_ENTITY_FLAG | mPendingCount++;
+    }
+
+    void EntityCommandBuffer::DestroyEntity(Entity entity)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        aCommands.push_back(Command{ Stamp(entity), 0, CommandType::CT_Destroy, 0 });
+    }
+
+    bool EntityCommandBuffer::Empty() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return aCommands.empty() && mPendingCount == 0;
+    }
+
+    void EntityCommandBuffer::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        ClearCommands();
+    }
+
+    EntityHandle EntityCommandBuffer::Stamp(Entity entity) const
+    {
+        if (IsPending(entity)) return EntityHandle{ entity, 0 };
+
+        // an entity that is already gone can never match, its commands are dropped on flush
+        if (!pCoordinator->HasActiveEntity(entity)) return EntityHandle{};
+
+        return pCoordinator->GetHandle(entity);
+    }
+
+    void EntityCommandBuffer::Flush()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (aCommands.empty() && mPendingCount == 0) return;
+
+        Coordinator& coordinator = *pCoordinator;
+
+        // pending entities destroyed before the flush are never created
+        std::vector<bool> pendingDestroyed(mPendingCount, false);
+        size_t createCount = mPendingCount;
+
+        for (const Command& command : aCommands)
+        {
+            if (command.op != CommandType::CT_Destroy || !IsPending(command.target.entity)) continue;
+
+            Entity index = command.target.entity & ~PENDING_ENTITY_FLAG;
+            if (index < pendingDestroyed.size() && !pendingDestroyed[index])
+            {
+                pendingDestroyed[index] = true;
+                --createCount;
+            }
+        }
+
+        std::vector<Entity> created;
+        coordinator.aEntityManager->CreateEntities(createCount, created);
+
+        assert((created.empty() || (created.back() & PENDING_ENTITY_FLAG) == 0) && "Error : Entity id collides with the pending ids.");
+
+        std::vector<Entity> pendingToEntity(mPendingCount, INVALID_ENTITY);
+        for (size_t i = 0, next = 0; i < pendingToEntity.size() && next < created.size(); ++i)
+        {
+            if (pendingDestroyed[i]) continue;
+
+            pendingToEntity[i] = created[next++];
+
+            if (coordinator.aArchetypeStorage)
+            {
+                coordinator.aArchetypeStorage->CreateEntity(pendingToEntity[i]);
+            }
+        }
+
+        // resolve the pending ids, commands on destroyed / reused / unknown entities are dropped
+        std::vector<Command> commands;
+        commands.reserve(aCommands.size());
+
+        for (Command command : aCommands)
+        {
+            if (IsPending(command.target.entity))
+            {
+                Entity index = command.target.entity & ~PENDING_ENTITY_FLAG;
+
+                assert(index < pendingToEntity.size() && "Error : Pending entity belongs to another command buffer.");
+
+                Entity entity = index < pendingToEntity.size() ? pendingToEntity[index] : INVALID_ENTITY;
+                if (entity == INVALID_ENTITY) continue;
+
+                command.target = coordinator.GetHandle(entity);
+            }
+
+            if (!coordinator.IsValid(command.target)) continue;
+
+            commands.push_back(command);
+        }
+
+        // group by entity, stable so each entity keeps its recording order
+        std::stable_sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) { return a.target.entity < b.target.entity; });
+
+        std::vector<Entity> destroyed;
+        std::vector<Entity> changed;
+        std::vector<Signature> signatures;
+        changed.reserve(created.size());
+        signatures.reserve(created.size());
+
+        size_t begin = 0;
+        while (begin < commands.size())
+        {
+            Entity entity = commands[begin].target.entity;
+
+            size_t end = begin;
+            bool destroy = false;
+            while (end < commands.size() && commands[end].target.entity == entity)
+            {
+                destroy |= commands[end].op == CommandType::CT_Destroy;
+                ++end;
+            }
+
+            if (destroy)
+            {
+                destroyed.push_back(entity);
+                begin = end;
+                continue;
+            }
+
+            // only the last add / remove of every component type counts, walk backwards and skip the seen types
+            Signature signature = coordinator.aEntityManager->GetSignature(entity);
+            Signature seen;
+
+            for (size_t i = end; i-- > begin;)
+            {
+                const Command& command = commands[i];
+
+                if (seen.test(command.type)) continue;
+                seen.set(command.type);
+
+                BaseCommandStore& store = *aStores[command.type];
+                bool owned = signature.test(command.type);
+
+                if (command.op == CommandType::CT_AddComponent)
+                {
+                    store.Add(coordinator, entity, command.payload, owned);
+                    signature.set(command.type);
+                }
+                else if (owned)
+                {
+                    store.Remove(coordinator, entity);
+                    signature.reset(command.type);
+                }
+            }
+
+            coordinator.aEntityManager->SetSignature(entity, signature);
+            changed.push_back(entity);
+            signatures.push_back(signature);
+
+            begin = end;
+        }
+
+        // created entities without any command still join the systems with an empty signature
+        // a created entity can't be in destroyed, its pending id was never resolved
+        size_t changedCount = changed.size(); // sorted by entity up to here
+        for (Entity entity : created)
+        {
+            if (std::binary_search(changed.begin(), changed.begin() + changedCount, entity)) continue;
+
+            changed.push_back(entity);
+            signatures.push_back(Signature{});
+        }
+
+        coordinator.aSystemManager->EntitiesSignatureChanged(changed, signatures);
+        coordinator.DestroyEntities(destroyed);
+        coordinator.EntitiesCreated(created.size());
+
+        ClearCommands();
+    }
+
+    void EntityCommandBuffer::ClearCommands()
+    {
+        aCommands.clear();
+        for (auto& store : aStores)
+        {
+            if (store) store->Clear();
+        }
+        mPendingCount = 0;
+    }
+}
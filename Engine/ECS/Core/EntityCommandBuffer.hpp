@@ -0,0 +1,192 @@
+/*!
+\file   EntityCommandBuffer.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements EntityCommandBuffer, a recorder for deferred structural changes (create / destroy / add / remove).
+
+Systems iterate aEntities and the component pools directly, so creating, destroying or adding components in the
+middle of an update can swap and pop the container being walked. Commands are recorded here instead and applied by
+Flush at a sync point of the frame (Coordinator::FlushCommands). Recording is guarded by a mutex so jobs running on
+other threads can record into the same buffer.
+
+Create returns a pending entity id that can be used by later commands of the same buffer, it becomes a real entity
+on Flush. Commands remember the generation of their entity, so a command on an entity destroyed (and possibly reused) before
+the flush is dropped. Flush sorts the commands by entity and merges them before touching the storage: a destroyed entity skips
+its other commands (a pending one is never created), and only the last add / remove of each component type of an
+entity is applied. System membership is updated once for the whole flush.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include "Coordinator.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+#include <cassert>
+
+namespace Uma_ECS
+{
+    class EntityCommandBuffer
+    {
+    public:
+        explicit EntityCommandBuffer(Coordinator& coordinator) : pCoordinator(&coordinator) {}
+
+        EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+        EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+        // returns a pending id, only valid for commands of this buffer until the next Flush
+        Entity CreateEntity();
+
+        void DestroyEntity(Entity entity);
+
+        template<typename T>
+        void AddComponent(Entity entity, T component)
+        {
+            ComponentType type = pCoordinator->GetComponentType<T>();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            CommandStore<T>& store = GetStore<T>(type);
+            aCommands.push_back(Command{ Stamp(entity), type, CommandType::CT_AddComponent, store.Push(std::move(component)) });
+        }
+
+        template<typename T>
+        void RemoveComponent(Entity entity)
+        {
+            ComponentType type = pCoordinator->GetComponentType<T>();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            GetStore<T>(type);
+            aCommands.push_back(Command{ Stamp(entity), type, CommandType::CT_RemoveComponent, 0 });
+        }
+
+        // applies every recorded command, must not run while other threads are recording
+        void Flush();
+
+        bool Empty() const;
+
+        // drops every recorded command without applying it
+        void Clear();
+
+        // true for the ids handed out by CreateEntity before they are flushed
+        static inline bool IsPending(Entity entity) { return entity != INVALID_ENTITY && (entity & PENDING_ENTITY_FLAG); }
+
+    private:
+        // pending ids have the top bit set, real ids never get that high
+        static constexpr Entity PENDING_ENTITY_FLAG = Entity{ 1 } << (sizeof(Entity) * 8 - 1);
+
+        enum class CommandType : uint8_t
+        {
+            CT_Destroy,
+            CT_AddComponent,
+            CT_RemoveComponent
+        };
+
+        struct Command
+        {
+            EntityHandle target;    // generation at record time, commands on a destroyed / reused id are dropped
+            ComponentType type;
+            CommandType op;
+            size_t payload;     // index of the component in the store of type (adds only)
+        };
+
+        // recorded component values of one type, applied through the typed Coordinator helpers
+        class BaseCommandStore
+        {
+        public:
+            virtual ~BaseCommandStore() = default;
+
+            virtual void Add(Coordinator& coordinator, Entity entity, size_t index, bool replace) = 0;
+            virtual void Remove(Coordinator& coordinator, Entity entity) = 0;
+            virtual void Clear() = 0;
+        };
+
+        template<typename T>
+        class CommandStore : public BaseCommandStore
+        {
+        public:
+            size_t Push(T&& component)
+            {
+                aComponents.push_back(std::move(component));
+                return aComponents.size() - 1;
+            }
+
+            void Add(Coordinator& coordinator, Entity entity, size_t index, bool replace) override
+            {
+                if (replace)
+                {
+                    coordinator.GetComponent<T>(entity) = std::move(aComponents[index]);
+                }
+                else
+                {
+                    coordinator.EmplaceComponentData<T>(entity, std::move(aComponents[index]));
+                }
+            }
+
+            void Remove(Coordinator& coordinator, Entity entity) override
+            {
+                coordinator.RemoveComponentData<T>(entity);
+            }
+
+            void Clear() override
+            {
+                aComponents.clear();
+            }
+
+        private:
+            std::vector<T> aComponents;
+        };
+
+        template<typename T>
+        CommandStore<T>& GetStore(ComponentType type)
+        {
+            assert(type < MAX_COMPONENTS && "Error : Component type out of range.");
+
+            if (aStores.size() <= type)
+            {
+                aStores.resize(static_cast<size_t>(type) + 1);
+            }
+
+            if (!aStores[type])
+            {
+                aStores[type] = std::make_unique<CommandStore<T>>();
+            }
+
+            return *static_cast<CommandStore<T>*>(aStores[type].get());
+        }
+
+        // caller holds mMutex
+        void ClearCommands();
+
+        // handle of the entity as it is now, pending ids are kept as they are
+        EntityHandle Stamp(Entity entity) const;
+
+        Coordinator* pCoordinator = nullptr;
+
+        mutable std::mutex mMutex;
+
+        // in recording order
+        std::vector<Command> aCommands;
+
+        // indexed by ComponentType
+        std::vector<std::unique_ptr<BaseCommandStore>> aStores;
+
+        Entity mPendingCount = 0;
+    };
+}
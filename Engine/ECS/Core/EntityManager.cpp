@@ -10,11 +10,12 @@
 \par    DigiPen login: waimen.leong
 
 \brief
-Implements entity lifecycle management using a free-list queue pattern for ID reuse.
+Implements entity lifecycle management using a dense alive list and an intrusive free list for ID reuse.
 
-Creates entities by popping from available IDs queue, destroys entities by resetting signatures and returning IDs to the pool.
-Tracks active entity count and maintains per-entity signatures and active status flags.
-Provides entity enumeration for serialization and batch operations with bounds checking and assertion-based validation.
+Creates entities by unlinking the oldest id from the free list (or taking the next new ID and growing the records),
+destroys entities by resetting the signature, swapping the last live entity into the freed dense slot, bumping the
+generation and appending the id to the free list. A destroyed entity is enabled again for the next owner of the id.
+Provides entity enumeration for serialization and batch operations in O(live) with assertion-based validation.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -23,96 +24,216 @@ All rights reserved.
 //#include "Precompiled.h"
 #include "EntityManager.hpp"
 
-#include <iostream>
 #include <cassert>
+#include <algorithm>
 
 Uma_ECS::EntityManager::EntityManager()
 {
-    mActiveEntityCnt = 0;
+    mFreeHead = INVALID_ENTITY;
+    mFreeTail = INVALID_ENTITY;
+}
+
+Uma_ECS::Entity Uma_ECS::EntityManager::CreateEntity()
+{
+    Entity new_entity;
 
-    // fill the available entities to the container
-    for (Entity e = 0; e < MAX_ENTITIES; e++)
+    if (mFreeHead != INVALID_ENTITY)
+    {
+        // unlink the oldest destroyed id and reuse it
+        new_entity = mFreeHead;
+        mFreeHead = aRecords[new_entity].link;
+        if (mFreeHead == INVALID_ENTITY)
+        {
+            mFreeTail = INVALID_ENTITY;
+        }
+    }
+    else
     {
-        aAvailableEntities.emplace(e);
+        // out of range check
+        assert(aRecords.size() < MAX_ENTITIES && "ERROR : Too many active entities.");
+
+        if (aRecords.size() >= MAX_ENTITIES) return INVALID_ENTITY;
+
+        new_entity = static_cast<Entity>(aRecords.size());
+        aRecords.emplace_back();
+        aSignatures.emplace_back();
+        aDisabled.emplace_back(0);
     }
+
+    aRecords[new_entity].link = static_cast<Entity>(aAliveEntities.size());
+    aAliveEntities.push_back(new_entity);
+
+    return new_entity;
 }
 
-Uma_ECS::Entity Uma_ECS::EntityManager::CreateEntity()
+void Uma_ECS::EntityManager::CreateEntities(size_t count, std::vector<Entity>& out)
 {
+    out.reserve(out.size() + count);
+    aAliveEntities.reserve(aAliveEntities.size() + count);
+
+    // reuse the destroyed ids first
+    while (count > 0 && mFreeHead != INVALID_ENTITY)
+    {
+        out.push_back(CreateEntity());
+        --count;
+    }
+
     // out of range check
-    assert(mActiveEntityCnt < MAX_ENTITIES && "ERROR : Too many active entities.");
+    assert(count <= static_cast<size_t>(MAX_ENTITIES) - aRecords.size() && "ERROR : Too many active entities.");
 
-    if (mActiveEntityCnt >= MAX_ENTITIES) return 0;
+    count = std::min(count, static_cast<size_t>(MAX_ENTITIES) - aRecords.size());
 
-    // pop the queue and set the new entity id
-    Entity new_entity = aAvailableEntities.front();
-    aAvailableEntities.pop();
-    aEntityActive[new_entity] = true;
-    ++mActiveEntityCnt;
+    // the rest are new ids, the per entity arrays are grown once for the whole batch
+    Entity first = static_cast<Entity>(aRecords.size());
+    aRecords.resize(aRecords.size() + count);
+    aSignatures.resize(aSignatures.size() + count);
+    aDisabled.resize(aDisabled.size() + count, 0);
 
-    return new_entity;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Entity entity = first + static_cast<Entity>(i);
+
+        aRecords[entity].link = static_cast<Entity>(aAliveEntities.size());
+        aAliveEntities.push_back(entity);
+        out.push_back(entity);
+    }
 }
 
 void Uma_ECS::EntityManager::DestroyEntity(Entity entity)
 {
     // check if id is valid and whether this entity is active
-    assert(entity >= 0 && entity < MAX_ENTITIES && "ERROR : Entity id is Invalid.");
-    assert(aEntityActive[entity] && "ERROR: Attempting to destroy an already inactive entity.");
+    assert(entity < aRecords.size() && "ERROR : Entity id is Invalid.");
+    assert(IsEntityActive(entity) && "ERROR: Attempting to destroy an already inactive entity.");
 
     // reset the signature of the entity 
     aSignatures[entity].reset();
 
-    // add the id back to the container for reuse
-    aAvailableEntities.emplace(entity);
-    aEntityActive[entity] = false;
-    --mActiveEntityCnt;
+    // the id's next owner starts enabled
+    if (aDisabled[entity])
+    {
+        aDisabled[entity] = 0;
+        --mDisabledCount;
+    }
+
+    // swap and pop the dense list, the moved entity's record follows it
+    EntityRecord& record = aRecords[entity];
+    Entity last = aAliveEntities.back();
+
+    aAliveEntities[record.link] = last;
+    aRecords[last].link = record.link;
+    aAliveEntities.pop_back();
+
+#ifndef ECS_NO_GENERATION_CHECK
+    // every handle to this id is stale from now on
+    ++record.generation;
+#endif
+
+    // append the id to the free list for reuse
+    record.link = INVALID_ENTITY;
+    if (mFreeTail != INVALID_ENTITY)
+    {
+        aRecords[mFreeTail].link = entity;
+    }
+    else
+    {
+        mFreeHead = entity;
+    }
+    mFreeTail = entity;
 }
 
 bool Uma_ECS::EntityManager::HasActiveEntity(Entity entity) const
 {
-    return aEntityActive[entity];
+    return IsEntityActive(entity);
 }
 
 void Uma_ECS::EntityManager::SetSignature(Entity entity, const Signature& signature)
 {
-    assert(entity >= 0 && entity < MAX_ENTITIES && "ERROR : Entity id is Invalid.");
+    assert(entity < aRecords.size() && "ERROR : Entity id is Invalid.");
 
     aSignatures[entity] = signature;
 }
 
 Uma_ECS::Signature Uma_ECS::EntityManager::GetSignature(Entity entity) const
 {
-    assert(entity >= 0 && entity < MAX_ENTITIES && "ERROR : Entity id is Invalid.");
+    assert(entity < aRecords.size() && "ERROR : Entity id is Invalid.");
 
     return aSignatures[entity];
 }
 
 int Uma_ECS::EntityManager::GetEntityCount() const
 {
-    return static_cast<int>(mActiveEntityCnt);
+    return static_cast<int>(aAliveEntities.size());
 }
 
 std::vector<Uma_ECS::Entity> Uma_ECS::EntityManager::GetAllEntites() const
 {
-    std::vector<Entity> allEntities;
+    return aAliveEntities;
+}
+
+Uma_ECS::EntityHandle Uma_ECS::EntityManager::GetHandle(Entity entity) const
+{
+    assert(IsEntityActive(entity) && "ERROR : Entity id is Invalid.");
 
-    allEntities.reserve(mActiveEntityCnt);
+#ifndef ECS_NO_GENERATION_CHECK
+    return EntityHandle{ entity, aRecords[entity].generation };
+#else
+    return EntityHandle{ entity, 0 };
+#endif
+}
 
-    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity)
+bool Uma_ECS::EntityManager::IsValid(const EntityHandle& handle) const
+{
+#ifndef ECS_NO_GENERATION_CHECK
+    return IsEntityActive(handle.entity) && aRecords[handle.entity].generation == handle.generation;
+#else
+    return IsEntityActive(handle.entity);
+#endif
+}
+
+void Uma_ECS::EntityManager::DestroyAllEntities()
+{
+    // same as DestroyEntity on every live entity, without the swap and pop of the dense list
+    for (Entity entity : aAliveEntities)
     {
-        if (aEntityActive[entity])
+        aSignatures[entity].reset();
+        aDisabled[entity] = 0;
+
+        EntityRecord& record = aRecords[entity];
+#ifndef ECS_NO_GENERATION_CHECK
+        ++record.generation;
+#endif
+
+        record.link = INVALID_ENTITY;
+        if (mFreeTail != INVALID_ENTITY)
+        {
+            aRecords[mFreeTail].link = entity;
+        }
+        else
         {
-            allEntities.push_back(entity);
+            mFreeHead = entity;
         }
+        mFreeTail = entity;
     }
-    return allEntities;
+
+    aAliveEntities.clear();
+    mDisabledCount = 0;
 }
 
-void Uma_ECS::EntityManager::DestroyAllEntities()
+void Uma_ECS::EntityManager::SetEnabled(Entity entity, bool enabled)
 {
-    //std::vector<Entity> entityList = GetAllEntites();
-    //for (auto const& entity : entityList)
-    //{
-    //    DestroyEntity(entity);
-    //}
+    assert(IsEntityActive(entity) && "ERROR : Entity id is Invalid.");
+
+    uint8_t disabled = enabled ? 0 : 1;
+    if (aDisabled[entity] == disabled) return;
+
+    aDisabled[entity] = disabled;
+
+    if (enabled)
+    {
+        --mDisabledCount;
+    }
+    else
+    {
+        ++mDisabledCount;
+    }
 }
@@ -10,12 +10,15 @@
 \par    DigiPen login: waimen.leong
 
 \brief
-Manages entity IDs, signatures, and lifecycle state using fixed-size arrays and a reuse queue.
+Manages entity IDs, signatures, and lifecycle state using a dense alive list and an intrusive free list.
 
-Maintains a queue of available entity IDs (0 to MAX_ENTITIES-1) for efficient allocation and reuse.
-Stores per-entity component signatures (bitsets) and active status flags for validation.
-Provides entity creation with ID recycling, destruction with signature cleanup, signature queries,
-and active entity enumeration. Supports up to MAX_ENTITIES (11,000) concurrent entities.
+Live entities are kept packed in aAliveEntities, every id's record points back at its slot in that list, so
+enumeration costs O(live) and removal is a swap and pop. A destroyed id's record is reused as a link of the free list
+(no separate container), ids are recycled oldest first. Every record carries a generation that is bumped on destroy so
+an EntityHandle to a destroyed id is rejected with a single compare, define ECS_NO_GENERATION_CHECK to compile the
+generations out. There is no fixed entity capacity, only INVALID_ENTITY is reserved.
+An entity can be disabled in place, it keeps its id, signature, components and system membership and is only flagged
+in aDisabled for views and systems to skip, so pooled entities are toggled without any structural change.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -24,9 +27,8 @@ All rights reserved.
 #pragma once
 
 #include "Types.hpp"
-#include <queue>
-#include <array>
 #include <vector>
+#include <cstdint>
 
 namespace Uma_ECS
 {
@@ -36,6 +38,10 @@ namespace Uma_ECS
         EntityManager();
 
         Entity CreateEntity();
+
+        // creates count entities and appends their ids to out, recycled ids first, storage grows once
+        void CreateEntities(size_t count, std::vector<Entity>& out);
+
         void DestroyEntity(Entity entity);
 
         bool HasActiveEntity(Entity entity) const;
@@ -47,20 +53,61 @@ namespace Uma_ECS
 
         std::vector<Entity> GetAllEntites() const;
 
-        inline bool IsEntityActive(Entity en) { return aEntityActive[en]; }
+        // packed list of the live entities, no copy, invalidated by create / destroy
+        inline const std::vector<Entity>& GetAliveEntities() const { return aAliveEntities; }
+
+        inline bool IsEntityActive(Entity en) const
+        {
+            // alive when the dense slot it points at points back at it
+            return en < aRecords.size() && aRecords[en].link < aAliveEntities.size() && aAliveEntities[aRecords[en].link] == en;
+        }
+
+        // handle of a live entity, stays comparable after the id is destroyed and reused
+        EntityHandle GetHandle(Entity entity) const;
 
+        // true if the handle's entity is alive and (with generation checks) is still the same generation
+        bool IsValid(const EntityHandle& handle) const;
+
+        // destroys every live entity in one pass, generations are bumped and the ids go to the free list
         void DestroyAllEntities();
 
+        // a disabled entity stays alive and keeps its components, only the flag changes
+        void SetEnabled(Entity entity, bool enabled);
+
+        inline bool IsEnabled(Entity entity) const { return entity >= aDisabled.size() || !aDisabled[entity]; }
+
+        // number of live disabled entities, views skip the flag test entirely while this is 0
+        inline size_t GetDisabledCount() const { return mDisabledCount; }
+
+        // indexed by entity id, non zero when disabled
+        inline const std::vector<uint8_t>& GetDisabledFlags() const { return aDisabled; }
+
     private:
 
-        // a queue of all the unused entities id
-        std::queue<Entity> aAvailableEntities{};
+        // one per entity id ever handed out
+        struct EntityRecord
+        {
+            // index into aAliveEntities while alive, next id of the free list while destroyed
+            Entity link = INVALID_ENTITY;
+#ifndef ECS_NO_GENERATION_CHECK
+            EntityGeneration generation = 0;
+#endif
+        };
 
-        std::array<Signature, MAX_ENTITIES> aSignatures{};
-        std::array<bool, MAX_ENTITIES> aEntityActive{};
+        std::vector<EntityRecord> aRecords{};
 
-        unsigned int mActiveEntityCnt{};
-    };
-}
+        // indexed by entity id, sized to the highest id handed out so far
+        std::vector<Signature> aSignatures{};
 
+        // live entities, packed
+        std::vector<Entity> aAliveEntities{};
 
+        // indexed by entity id like aSignatures, non zero when disabled
+        std::vector<uint8_t> aDisabled{};
+        size_t mDisabledCount = 0;
+
+        // destroyed ids, oldest first, linked through EntityRecord::link
+        Entity mFreeHead = INVALID_ENTITY;
+        Entity mFreeTail = INVALID_ENTITY;
+    };
+}
@@ -0,0 +1,79 @@
+/*!
+\file   Prefab.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements Prefab, the in-memory template a prefab file or a live entity is converted to once.
+
+A Prefab holds the signature of its instances and one typed value per component (PrefabComponent), each tagged with
+the ComponentType of its pool. Instantiating copies every value into its pool as one batched add for the whole batch
+of instances, so spawning reads no JSON and does no name lookup. The template doesn't live in the world, it is never
+seen by systems, views or serialization.
+Prefabs are built by ComponentManager::MakePrefab and cached by Coordinator::LoadPrefab.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include <vector>
+#include <memory>
+
+namespace Uma_ECS
+{
+    class BaseComponentArray;
+
+    // one component value of a prefab
+    class BasePrefabComponent
+    {
+    public:
+        virtual ~BasePrefabComponent() = default;
+
+        // adds a copy of the value to every entity, pool is the pool of the component's type
+        virtual void AddTo(BaseComponentArray& pool, const std::vector<Entity>& entities) const = 0;
+    };
+
+    // Pool is the pool storing T (ComponentArray<T> or SharedComponentArray<T>)
+    template<typename Pool, typename T>
+    class PrefabComponent : public BasePrefabComponent
+    {
+    public:
+        explicit PrefabComponent(T value) : mValue(std::move(value)) {}
+
+        void AddTo(BaseComponentArray& pool, const std::vector<Entity>& entities) const override
+        {
+            static_cast<Pool&>(pool).AddData(entities, mValue);
+        }
+
+        inline const T& GetValue() const { return mValue; }
+
+    private:
+        T mValue;
+    };
+
+    struct Prefab
+    {
+        struct Component
+        {
+            ComponentType type;
+            std::unique_ptr<BasePrefabComponent> value;
+        };
+
+        // signature of every instance
+        Signature signature;
+
+        // in ComponentType order
+        std::vector<Component> aComponents;
+
+        inline bool IsEmpty() const { return aComponents.empty(); }
+    };
+}
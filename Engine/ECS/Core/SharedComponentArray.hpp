@@ -0,0 +1,423 @@
+/*!
+\file   SharedComponentArray.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements SharedComponentArray, the storage of shared (flyweight) components, one value referenced by many entities.
+
+Entities are grouped by value, every distinct value is stored once in a group together with its hot record
+(HotData) and the packed list of the entities referencing it, so hundreds of walls using the same sprite cost one
+Sprite instead of hundreds. Setting a value looks up the group holding an equal value (operator==) and moves the
+entity into it, a group is recycled once its last entity leaves. Systems walk the groups with ForEachGroup, eg.
+RenderingSystem emits one instanced batch per group without building a per frame map.
+The pool is registered as the component type Shared<T>, so a signature can require the shared and the per entity
+version of a component independently. Changes are tracked per entity (join / leave) and per group (MarkGroupChanged),
+ChangedSince reports both so Changed<Shared<T>> filters work like the per entity pools.
+Serialization writes the value of the entity's group under the name of Shared<T>.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include "ComponentArray.hpp"
+#include <vector>
+#include <cassert>
+#include <string>
+#include <type_traits>
+
+#include "rapidjson/document.h"		// rapidjson's DOM-style API
+
+namespace Uma_ECS
+{
+    // component type of the shared version of T, registered with RegisterSharedComponent<T>
+    // eg. sign.set(coordinator.GetComponentType<Shared<Sprite>>());
+    template<typename T>
+    struct Shared {};
+
+    template<typename T>
+    inline constexpr bool IsShared = false;
+
+    template<typename T>
+    inline constexpr bool IsShared<Shared<T>> = true;
+
+    template <typename T>
+    class SharedComponentArray : public BaseComponentArray
+    {
+    public:
+        // runtime half of a split component, one per group
+        static constexpr bool HAS_HOT_DATA = !std::is_void_v<typename HotData<T>::type>;
+        using Hot = std::conditional_t<HAS_HOT_DATA, typename HotData<T>::type, NoHotData>;
+
+        // index of a group, stays valid while an entity references the group
+        using GroupIndex = Entity;
+
+        SharedComponentArray() = default;
+
+        // the entity joins the group holding value, a group is made when no live group holds an equal value
+        ECSErrorCode AddData(Entity entity, const T& value)
+        {
+#ifndef NDEBUG
+            assert(!Has(entity) && "Error : Same component is being added again.");
+#else
+            if (Has(entity))
+            {
+                return ECSErrorCode::EC_ComponentAlreadyExists;
+            }
+#endif
+            Join(entity, FindOrCreateGroup(value));
+
+            return ECSErrorCode::EC_None;
+        }
+
+        // every entity joins the group holding value, the group is looked up once
+        ECSErrorCode AddData(const std::vector<Entity>& entities, const T& value)
+        {
+            for (Entity entity : entities)
+            {
+#ifndef NDEBUG
+                assert(!Has(entity) && "Error : Same component is being added again.");
+#else
+                if (Has(entity))
+                {
+                    return ECSErrorCode::EC_ComponentAlreadyExists;
+                }
+#endif
+            }
+
+            JoinAll(entities, FindOrCreateGroup(value));
+
+            return ECSErrorCode::EC_None;
+        }
+
+        // moves the entity to the group holding value, its old group is recycled once empty
+        ECSErrorCode SetData(Entity entity, const T& value)
+        {
+#ifndef NDEBUG
+            assert(Has(entity) && "Error : This entity doesn't contain this component.");
+#else
+            if (!Has(entity))
+            {
+                return ECSErrorCode::EC_ComponentNotFound;
+            }
+#endif
+            if (aGroups[aSlots[entity].group].value == value) return ECSErrorCode::EC_None;
+
+            Leave(entity);
+            Join(entity, FindOrCreateGroup(value));
+
+            return ECSErrorCode::EC_None;
+        }
+
+        ECSErrorCode RemoveData(Entity entity)
+        {
+#ifndef NDEBUG
+            assert(Has(entity) && "Error : This entity doesn't contain this component.");
+#else
+            if (!Has(entity))
+            {
+                return ECSErrorCode::EC_ComponentNotFound;
+            }
+#endif
+            Leave(entity);
+
+            return ECSErrorCode::EC_None;
+        }
+
+        // the value is shared, writes go through SetData so the entity changes group instead of editing the others
+        const T& GetData(Entity entity) const
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            return aGroups[aSlots[entity].group].value;
+        }
+
+        // hot record of the entity's group, nullptr if the entity doesn't own this component
+        Hot* TryGetHot(Entity entity)
+        {
+            return Has(entity) ? &aGroups[aSlots[entity].group].hot : nullptr;
+        }
+
+        // group of the entity, INVALID_ENTITY if the entity doesn't own this component
+        inline GroupIndex GetGroup(Entity entity) const
+        {
+            return entity < aSlots.size() ? aSlots[entity].group : INVALID_ENTITY;
+        }
+
+        // live and recycled groups, GroupIndex runs from 0 to GroupCount()
+        inline size_t GroupCount() const { return aGroups.size(); }
+
+        // groups referenced by at least one entity
+        inline size_t LiveGroupCount() const { return aGroups.size() - aFreeGroups.size(); }
+
+        inline bool IsGroupAlive(GroupIndex group) const { return !aGroups[group].aEntities.empty(); }
+
+        inline const T& GetGroupValue(GroupIndex group) const { return aGroups[group].value; }
+
+        // runtime data resolved once for the whole group (eg. the texture of a shared sprite)
+        inline Hot& GetGroupHot(GroupIndex group) { return aGroups[group].hot; }
+
+        inline const std::vector<Entity>& GetGroupEntities(GroupIndex group) const { return aGroups[group].aEntities; }
+
+        inline ChangeTick GetGroupChangeTick(GroupIndex group) const { return aGroups[group].tick; }
+
+        // stamps the group, every entity in it counts as changed for Changed<Shared<T>> filters
+        inline void MarkGroupChanged(GroupIndex group) { aGroups[group].tick = CurrentTick(); }
+
+        // calls func(GroupIndex, const T&, Hot&, const std::vector<Entity>&) for every live group
+        template<typename Func>
+        void ForEachGroup(Func&& func)
+        {
+            for (GroupIndex group = 0; group < aGroups.size(); ++group)
+            {
+                Group& g = aGroups[group];
+                if (g.aEntities.empty()) continue;
+
+                func(group, g.value, g.hot, g.aEntities);
+            }
+        }
+
+        // number of entities owning the component
+        inline size_t Size() const { return mCount; }
+
+        void DestroyEntity(Entity entity) override
+        {
+            if (Has(entity))
+            {
+                Leave(entity);
+            }
+        }
+
+        bool Has(Entity entity) const override
+        {
+            return entity < aSlots.size() && aSlots[entity].group != INVALID_ENTITY;
+        }
+
+        // joining a group and a change of the group's value / hot record both count
+        bool ChangedSince(Entity entity, ChangeTick since) const override
+        {
+            if (!Has(entity)) return false;
+
+            const Slot& slot = aSlots[entity];
+            return slot.tick > since || aGroups[slot.group].tick > since;
+        }
+
+        void MarkChanged(Entity entity) override
+        {
+            assert(Has(entity) && "ERROR : Entity doesnt contain this data.");
+
+            aSlots[entity].tick = CurrentTick();
+        }
+
+        // dest joins the group of src, nothing is copied
+        void CloneComponent(Entity src, Entity dest) override
+        {
+            if (!Has(src)) return;
+
+            Join(dest, aSlots[src].group);
+        }
+
+        void AddDefaultData(const std::vector<Entity>& entities) override
+        {
+            if (entities.empty()) return;
+
+            JoinAll(entities, FindOrCreateGroup(T{}));
+        }
+
+        void CloneComponent(Entity src, const std::vector<Entity>& dests) override
+        {
+            if (!Has(src)) return;
+
+            JoinAll(dests, aSlots[src].group);
+        }
+
+        void Clear() override
+        {
+            aGroups.clear();
+            aFreeGroups.clear();
+            aSlots.clear();
+            mCount = 0;
+        }
+
+        // one value per group written through SetData only, nothing to double buffer
+        void SwapBuffers() override
+        {
+        }
+
+        // the values are stored per group, nothing to reorder
+        bool DefragmentStep(size_t) override
+        {
+            return true;
+        }
+
+        // componentCount is the number of entities, the dense part is the groups (one value each) and their entity lists
+        PoolMemoryReport GetMemoryReport() const override
+        {
+            PoolMemoryReport report;
+            report.componentCount = mCount;
+            report.denseCapacity = aGroups.capacity();
+            report.denseBytes = aGroups.capacity() * sizeof(Group) + aFreeGroups.capacity() * sizeof(GroupIndex);
+
+            for (const Group& group : aGroups)
+            {
+                report.denseBytes += group.aEntities.capacity() * sizeof(Entity);
+            }
+
+            report.sparseBytes = aSlots.capacity() * sizeof(Slot);
+
+            return report;
+        }
+
+        // serialization and deserialization
+        void Serialize(Entity entity, rapidjson::Value& comps, rapidjson::Document::AllocatorType& allocator) override
+        {
+            if (!Has(entity)) return; // entity not exists
+
+            rapidjson::Value componentObj;
+            aGroups[aSlots[entity].group].value.Serialize(componentObj, allocator);
+            comps.AddMember(rapidjson::StringRef(typeid(Shared<T>).name()), componentObj, allocator);
+        }
+
+        std::string Deserialize(Entity entity, const rapidjson::Value& comps) override
+        {
+            std::string compType = "";
+            if (comps.HasMember(typeid(Shared<T>).name()))
+            {
+                T value;
+                value.Deserialize(comps[typeid(Shared<T>).name()]);
+                AddData(entity, value);
+
+                compType = typeid(Shared<T>).name();
+            }
+            return compType;
+        }
+
+        // the instances of the prefab join the group holding the value
+        std::unique_ptr<BasePrefabComponent> CapturePrefab(Entity entity) const override
+        {
+            if (!Has(entity)) return nullptr;
+
+            return std::make_unique<PrefabComponent<SharedComponentArray<T>, T>>(GetData(entity));
+        }
+
+        std::unique_ptr<BasePrefabComponent> DeserializePrefab(const rapidjson::Value& comps) const override
+        {
+            if (!comps.HasMember(typeid(Shared<T>).name())) return nullptr;
+
+            T value;
+            value.Deserialize(comps[typeid(Shared<T>).name()]);
+            return std::make_unique<PrefabComponent<SharedComponentArray<T>, T>>(std::move(value));
+        }
+
+    private:
+
+        // one distinct value and the entities referencing it
+        struct Group
+        {
+            T value{};
+            Hot hot{};
+            std::vector<Entity> aEntities;
+            ChangeTick tick = 0;
+        };
+
+        // per entity, indexed by entity id
+        struct Slot
+        {
+            GroupIndex group = INVALID_ENTITY;
+            Entity index = 0; // position in the group's entity list
+            ChangeTick tick = 0;
+        };
+
+        // few distinct values live at once (one per texture), a linear scan is cheaper than hashing every value
+        // a new group is empty, the caller joins at least one entity to it
+        GroupIndex FindOrCreateGroup(const T& value)
+        {
+            for (GroupIndex group = 0; group < aGroups.size(); ++group)
+            {
+                if (!aGroups[group].aEntities.empty() && aGroups[group].value == value) return group;
+            }
+
+            GroupIndex group;
+            if (!aFreeGroups.empty())
+            {
+                group = aFreeGroups.back();
+                aFreeGroups.pop_back();
+                aGroups[group].value = value;
+            }
+            else
+            {
+                group = static_cast<GroupIndex>(aGroups.size());
+                aGroups.push_back(Group{ value, {}, {}, 0 });
+            }
+
+            Group& g = aGroups[group];
+            g.hot = Hot{};
+            g.tick = CurrentTick();
+
+            if constexpr (HAS_HOT_DATA)
+            {
+                HotData<T>::Sync(g.value, g.hot);
+            }
+
+            return group;
+        }
+
+        void Join(Entity entity, GroupIndex group)
+        {
+            if (aSlots.size() <= entity)
+            {
+                aSlots.resize(static_cast<size_t>(entity) + 1);
+            }
+
+            std::vector<Entity>& entities = aGroups[group].aEntities;
+            aSlots[entity] = Slot{ group, static_cast<Entity>(entities.size()), CurrentTick() };
+            entities.push_back(entity);
+            ++mCount;
+        }
+
+        void JoinAll(const std::vector<Entity>& entities, GroupIndex group)
+        {
+            aGroups[group].aEntities.reserve(aGroups[group].aEntities.size() + entities.size());
+
+            for (Entity entity : entities)
+            {
+                Join(entity, group);
+            }
+        }
+
+        // swap-removes the entity from its group's list, an emptied group goes to the free list
+        void Leave(Entity entity)
+        {
+            Slot& slot = aSlots[entity];
+            std::vector<Entity>& entities = aGroups[slot.group].aEntities;
+
+            Entity last = entities.back();
+            entities[slot.index] = last;
+            aSlots[last].index = slot.index;
+            entities.pop_back();
+
+            if (entities.empty())
+            {
+                aFreeGroups.push_back(slot.group);
+            }
+
+            slot = Slot{};
+            --mCount;
+        }
+
+        std::vector<Group> aGroups;
+        std::vector<GroupIndex> aFreeGroups;
+        std::vector<Slot> aSlots;
+
+        size_t mCount = 0;
+    };
+}
@@ -0,0 +1,162 @@
+/*!
+\file   Signature.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements BitSignature, the fixed-size component bit set behind Uma_ECS::Signature.
+
+Bits are stored in 64-bit words and every comparison is done a word at a time, so the cost of a signature test
+grows with MAX_COMPONENTS / 64 instead of per component. Keeps the std::bitset calls the engine already uses
+(set / reset / test / & / ==) and adds Contains for the (entity & system) == system check, ForEachSetBit for walking
+the component types of a signature, and a std::hash specialisation so signatures can key unordered containers.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Uma_ECS
+{
+    template<size_t Bits>
+    class BitSignature
+    {
+    public:
+        static constexpr size_t WORD_BITS = 64;
+        static constexpr size_t WORD_COUNT = (Bits + WORD_BITS - 1) / WORD_BITS;
+
+        constexpr BitSignature() = default;
+
+        inline BitSignature& set(size_t pos, bool value = true)
+        {
+            uint64_t mask = uint64_t{ 1 } << (pos % WORD_BITS);
+            if (value)
+            {
+                aWords[pos / WORD_BITS] |= mask;
+            }
+            else
+            {
+                aWords[pos / WORD_BITS] &= ~mask;
+            }
+            return *this;
+        }
+
+        inline BitSignature& reset()
+        {
+            aWords.fill(0);
+            return *this;
+        }
+
+        inline BitSignature& reset(size_t pos)
+        {
+            return set(pos, false);
+        }
+
+        inline bool test(size_t pos) const
+        {
+            return (aWords[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1u;
+        }
+
+        inline bool any() const
+        {
+            for (uint64_t word : aWords)
+            {
+                if (word) return true;
+            }
+            return false;
+        }
+
+        inline bool none() const { return !any(); }
+
+        inline size_t count() const
+        {
+            size_t bits = 0;
+            for (uint64_t word : aWords)
+            {
+                bits += static_cast<size_t>(std::popcount(word));
+            }
+            return bits;
+        }
+
+        static constexpr size_t size() { return Bits; }
+
+        // true if every bit of required is also set here, same as (*this & required) == required
+        inline bool Contains(const BitSignature& required) const
+        {
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                if ((aWords[i] & required.aWords[i]) != required.aWords[i]) return false;
+            }
+            return true;
+        }
+
+        // calls func(size_t pos) for every set bit, lowest first
+        template<typename Func>
+        inline void ForEachSetBit(Func&& func) const
+        {
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                uint64_t word = aWords[i];
+                while (word)
+                {
+                    func(i * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+                    word &= word - 1; // clear the lowest set bit
+                }
+            }
+        }
+
+        inline BitSignature& operator&=(const BitSignature& rhs)
+        {
+            for (size_t i = 0; i < WORD_COUNT; ++i) aWords[i] &= rhs.aWords[i];
+            return *this;
+        }
+
+        inline BitSignature& operator|=(const BitSignature& rhs)
+        {
+            for (size_t i = 0; i < WORD_COUNT; ++i) aWords[i] |= rhs.aWords[i];
+            return *this;
+        }
+
+        friend inline BitSignature operator&(BitSignature lhs, const BitSignature& rhs) { return lhs &= rhs; }
+        friend inline BitSignature operator|(BitSignature lhs, const BitSignature& rhs) { return lhs |= rhs; }
+
+        friend inline bool operator==(const BitSignature& lhs, const BitSignature& rhs) { return lhs.aWords == rhs.aWords; }
+        friend inline bool operator!=(const BitSignature& lhs, const BitSignature& rhs) { return !(lhs == rhs); }
+
+        inline size_t Hash() const
+        {
+            // boost style hash_combine over the words
+            size_t seed = 0;
+            for (uint64_t word : aWords)
+            {
+                seed ^= std::hash<uint64_t>{}(word) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+
+    private:
+        std::array<uint64_t, WORD_COUNT> aWords{};
+    };
+}
+
+template<size_t Bits>
+struct std::hash<Uma_ECS::BitSignature<Bits>>
+{
+    size_t operator()(const Uma_ECS::BitSignature<Bits>& signature) const
+    {
+        return signature.Hash();
+    }
+};
@@ -14,6 +14,9 @@ Defines the base ECSSystem class that serves as the parent for all game logic sy
 
 Contains a vector of Entity IDs representing entities that match the system's component signature.
 Systems automatically receive entity additions/removals based on signature matching performed by SystemManager.
+An entity-to-slot index next to the vector makes membership checks, insertion and removal O(1).
+The list remembers whether it is still in ascending entity order, the defragmenter sorts it back when it isn't so
+iterating it walks the defragmented component pools front to back.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -31,7 +34,89 @@ namespace Uma_ECS
     {
     public:
 
+        // entities matching the system signature, read only for the systems, SystemManager keeps it up to date
         std::vector<Entity> aEntities;
 
+        inline bool HasEntity(Entity entity) const
+        {
+            return entity < aEntityToSlot.size() && aEntityToSlot[entity] != INVALID_ENTITY;
+        }
+
+        inline void InsertEntity(Entity entity)
+        {
+            if (aEntityToSlot.size() <= entity)
+            {
+                aEntityToSlot.resize(static_cast<size_t>(entity) + 1, INVALID_ENTITY);
+            }
+
+            if (aEntityToSlot[entity] != INVALID_ENTITY) return; // already in
+
+            if (!aEntities.empty() && entity < aEntities.back()) mOrdered = false;
+
+            aEntityToSlot[entity] = static_cast<Entity>(aEntities.size());
+            aEntities.push_back(entity);
+        }
+
+        inline void RemoveEntity(Entity entity)
+        {
+            if (!HasEntity(entity)) return;
+
+            // swap and pop
+            Entity slot = aEntityToSlot[entity];
+            Entity last = aEntities.back();
+
+            aEntities[slot] = last;
+            aEntityToSlot[last] = slot;
+
+            if (last != entity) mOrdered = false;
+
+            aEntities.pop_back();
+            aEntityToSlot[entity] = INVALID_ENTITY;
+        }
+
+        // sizes the slot index once before a batch of inserts
+        inline void ReserveSlots(Entity maxEntity)
+        {
+            if (aEntityToSlot.size() <= maxEntity)
+            {
+                aEntityToSlot.resize(static_cast<size_t>(maxEntity) + 1, INVALID_ENTITY);
+            }
+        }
+
+        // drops every entity, the slot index is emptied without visiting the entities
+        inline void ClearEntities()
+        {
+            aEntities.clear();
+            aEntityToSlot.clear();
+            mOrdered = true;
+        }
+
+        // true while aEntities is in ascending entity order, the order the defragmented pools are stored in
+        inline bool IsOrdered() const { return mOrdered; }
+
+        // puts aEntities back in ascending entity order, called by Coordinator::Defragment
+        // the slot index is already indexed by entity id, one linear pass instead of a comparison sort
+        void SortEntities()
+        {
+            Entity slot = 0;
+            for (Entity entity = 0; entity < aEntityToSlot.size(); ++entity)
+            {
+                if (aEntityToSlot[entity] == INVALID_ENTITY) continue;
+
+                aEntities[slot] = entity;
+                aEntityToSlot[entity] = slot++;
+            }
+
+            mOrdered = true;
+        }
+
+    private:
+
+        // entity id -> index into aEntities, INVALID_ENTITY if the entity is not in the system
+        std::vector<Entity> aEntityToSlot;
+
+        // false once an insert / swap-remove broke the ascending entity order
+        bool mOrdered = true;
+
     };
 }
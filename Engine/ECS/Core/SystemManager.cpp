@@ -13,7 +13,9 @@
 Implements system-entity membership management based on signature matching using bitwise operations.
 
 Handles entity removal from all systems when destroyed, and dynamically adds/removes entities from systems
-when their component signatures change. Uses swap-and-pop pattern for efficient entity removal from system vectors.
+when their component signatures change. Membership is kept in each ECSSystem's entity-to-slot index, so insertion
+and swap-and-pop removal are O(1). The bulk variants walk the batch once per system. EntityComponentChanged goes
+through the component-to-system index and skips every system that doesn't require the changed component.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -22,61 +24,218 @@ All rights reserved.
 #include "SystemManager.hpp"
 #include "System.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 void Uma_ECS::SystemManager::EntityDestroyed(Entity entity)
 {
     // remove the destroyed entity from all systems
-    for (auto const& pair : aSystems)
+    for (auto const& system : aSystems)
     {
-        // getting the system from the map
-        auto const& system = pair.second;
+        system->RemoveEntity(entity);
+    }
+}
+
+void Uma_ECS::SystemManager::EntitySignatureChanged(Entity entity, Signature entitySiganture)
+{
+    // Let each systems knows that the entity's signature had changed
+    for (size_t i = 0; i < aSystems.size(); ++i)
+    {
+        auto const& system = aSystems[i];
+        auto const& systemSignature = aSignatures[i];
+
+        // Check if the entity contains the components that are required for the system
+        // same as (entitySignature & systemSignature) == systemSignature, compared a word at a time
+        if (entitySiganture.Contains(systemSignature))
+        {
+            system->InsertEntity(entity);
+        }
+        else
+        {
+            system->RemoveEntity(entity);
+        }
+    }
+}
 
-        auto& entities = system->aEntities;
-        for (size_t i = 0; i < entities.size(); ++i) 
+void Uma_ECS::SystemManager::EntityComponentChanged(Entity entity, ComponentType type, const Signature& entitySignature)
+{
+    assert(type < MAX_COMPONENTS && "Error : Component type out of range.");
+
+    if (entitySignature.test(type))
+    {
+        // added, only systems requiring this type can start matching
+        for (size_t system : aComponentToSystems[type])
         {
-            if (entities[i] == entity) 
+            if (entitySignature.Contains(aSignatures[system]))
             {
-                entities[i] = entities.back();  // overwrite with last
-                entities.pop_back();            // shrink
-                break;                          // only one instance per system anyway
+                aSystems[system]->InsertEntity(entity);
             }
         }
     }
+    else
+    {
+        // removed, every system requiring this type stops matching
+        for (size_t system : aComponentToSystems[type])
+        {
+            aSystems[system]->RemoveEntity(entity);
+        }
+    }
+
+    for (size_t system : aUnfilteredSystems)
+    {
+        aSystems[system]->InsertEntity(entity);
+    }
 }
 
-void Uma_ECS::SystemManager::EntitySignatureChanged(Entity entity, Signature entitySiganture)
+void Uma_ECS::SystemManager::EntitiesDestroyed(const std::vector<Entity>& entities)
 {
-    // Let each systems knows that the entity's signature had changed
-    for (auto const& pair : aSystems)
+    for (auto const& system : aSystems)
     {
-        auto const& type = pair.first;
-        auto const& system = pair.second;
-        auto const& systemSignature = aSignatures[type];
+        for (Entity entity : entities)
+        {
+            system->RemoveEntity(entity);
+        }
+    }
+}
 
-        // Check if the entity contains the components that are required for the system
-        // basically using bitwise AND to compare both signatures
-        // it will return the bit that both signature have
-        // (entitySignature & systemSignature) == systemSignature
-        if ((entitySiganture & systemSignature) == systemSignature)
+bool Uma_ECS::SystemManager::SortNextEntityList()
+{
+    for (auto const& system : aSystems)
+    {
+        if (!system->IsOrdered())
         {
-            auto& entities = system->aEntities;
-            if (std::find(entities.begin(), entities.end(), entity) == entities.end()) // doesnt exist
+            system->SortEntities();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Uma_ECS::SystemManager::AllEntitiesDestroyed()
+{
+    for (auto const& system : aSystems)
+    {
+        system->ClearEntities();
+    }
+}
+
+void Uma_ECS::SystemManager::EntitiesSignatureChanged(const std::vector<Entity>& entities, const std::vector<Signature>& signatures)
+{
+    assert(entities.size() == signatures.size() && "Error : Every entity needs a signature.");
+
+    if (entities.empty()) return;
+
+    Entity maxEntity = *std::max_element(entities.begin(), entities.end());
+
+    for (size_t i = 0; i < aSystems.size(); ++i)
+    {
+        auto const& system = aSystems[i];
+        auto const& systemSignature = aSignatures[i];
+
+        // grow the slot index once for the whole batch instead of per insert
+        system->ReserveSlots(maxEntity);
+
+        for (size_t e = 0; e < entities.size(); ++e)
+        {
+            if (signatures[e].Contains(systemSignature))
             {
-                entities.emplace_back(entity);
+                system->InsertEntity(entities[e]);
+            }
+            else
+            {
+                system->RemoveEntity(entities[e]);
+            }
+        }
+    }
+}
+
+void Uma_ECS::SystemManager::EntitiesSignatureChanged(const std::vector<Entity>& entities, const Signature& signature)
+{
+    if (entities.empty()) return;
+
+    Entity maxEntity = *std::max_element(entities.begin(), entities.end());
+
+    for (size_t i = 0; i < aSystems.size(); ++i)
+    {
+        auto const& system = aSystems[i];
+
+        if (signature.Contains(aSignatures[i]))
+        {
+            system->ReserveSlots(maxEntity);
+
+            for (Entity entity : entities)
+            {
+                system->InsertEntity(entity);
             }
         }
         else
         {
-            auto& entities = system->aEntities;
-            for (size_t i = 0; i < entities.size(); ++i)
+            for (Entity entity : entities)
+            {
+                system->RemoveEntity(entity);
+            }
+        }
+    }
+}
+
+void Uma_ECS::SystemManager::EntitiesComponentChanged(const std::vector<Entity>& entities, ComponentType type, const std::vector<Signature>& signatures)
+{
+    assert(type < MAX_COMPONENTS && "Error : Component type out of range.");
+    assert(entities.size() == signatures.size() && "Error : Every entity needs a signature.");
+
+    if (entities.empty()) return;
+
+    Entity maxEntity = *std::max_element(entities.begin(), entities.end());
+
+    for (size_t system : aComponentToSystems[type])
+    {
+        auto const& systemSignature = aSignatures[system];
+        aSystems[system]->ReserveSlots(maxEntity);
+
+        for (size_t e = 0; e < entities.size(); ++e)
+        {
+            if (signatures[e].test(type) && signatures[e].Contains(systemSignature))
             {
-                if (entities[i] == entity)
-                {
-                    entities[i] = entities.back();  // overwrite with last
-                    entities.pop_back();            // shrink
-                    break;                          // only one instance per system anyway
-                }
+                aSystems[system]->InsertEntity(entities[e]);
+            }
+            else if (!signatures[e].test(type))
+            {
+                aSystems[system]->RemoveEntity(entities[e]);
             }
         }
-        
+    }
+
+    for (size_t system : aUnfilteredSystems)
+    {
+        aSystems[system]->ReserveSlots(maxEntity);
+
+        for (Entity entity : entities)
+        {
+            aSystems[system]->InsertEntity(entity);
+        }
+    }
+}
+
+void Uma_ECS::SystemManager::SetSignature(size_t system, const Signature& signature)
+{
+    auto removeFrom = [system](std::vector<size_t>& list)
+        {
+            list.erase(std::remove(list.begin(), list.end(), system), list.end());
+        };
+
+    // take the system out of the buckets of its old signature
+    aSignatures[system].ForEachSetBit([&](size_t type) { removeFrom(aComponentToSystems[type]); });
+    removeFrom(aUnfilteredSystems);
+
+    aSignatures[system] = signature;
+
+    if (signature.none())
+    {
+        aUnfilteredSystems.push_back(system);
+    }
+    else
+    {
+        signature.ForEachSetBit([&](size_t type) { aComponentToSystems[type].push_back(system); });
     }
 }
@@ -12,11 +12,15 @@
 \brief
 Manages registration and lifecycle of all ECS systems with signature-based entity filtering.
 
-Maps system type names to system instances (shared pointers) and their required component signatures.
+Keeps system instances (shared pointers) and their required component signatures in parallel vectors,
+indexed through SystemFamily ids instead of type name strings.
 Template methods provide type-safe system registration and signature configuration.
 Automatically updates system membership when entities are created, destroyed, or have components added/removed
 by comparing entity signatures with system signatures using bitwise AND operations. Systems only track entities
-that contain all required components specified in their signature.
+that contain all required components specified in their signature. Membership updates are O(1) per system through
+the entity-to-slot index on ECSSystem, batches of changed entities can be re-evaluated in one pass per system.
+An inverted index from component type to the systems requiring it lets a single Add/RemoveComponent re-check only
+the systems whose signature contains the flipped bit.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -25,10 +29,11 @@ All rights reserved.
 #pragma once
 
 #include "Types.hpp"
+#include "TypeFamily.hpp"
 #include "System.hpp"
 
-#include <string>
-#include <unordered_map>
+#include <array>
+#include <vector>
 #include <memory>
 #include <cassert>
 
@@ -43,35 +48,87 @@ namespace Uma_ECS
         template<typename T>
         std::shared_ptr<T> RegisterSystem()
         {
-            std::string type_name = std::string(typeid(T).name());
+            size_t family = SystemFamily::GetId<T>();
 
-            assert(aSystems.find(type_name) == aSystems.end() && "Error : Registering the system more than once.");
+            assert(!IsRegistered(family) && "Error : Registering the system more than once.");
+
+            if (aFamilyToSystem.size() <= family)
+            {
+                aFamilyToSystem.resize(family + 1, INVALID_SYSTEM);
+            }
+            aFamilyToSystem[family] = aSystems.size();
+
+            // an empty signature matches every entity until SetSignature is called
+            aUnfilteredSystems.push_back(aSystems.size());
 
             // Create a pointer to the system and return it, so that it can be used externally
             auto system = std::make_shared<T>();
-            aSystems.insert({ type_name, system });
+            aSystems.push_back(system);
+            aSignatures.push_back(Signature{});
             return system;
         }
         
         template<typename T> 
         void SetSignature(Signature signature)
         {
-            std::string type_name = std::string(typeid(T).name());
+            size_t family = SystemFamily::GetId<T>();
 
-            assert(aSystems.find(type_name) != aSystems.end() && "Error : setting the signature of the system before registering.");
+            assert(IsRegistered(family) && "Error : setting the signature of the system before registering.");
 
-            aSignatures.insert({ type_name, signature });
+            SetSignature(aFamilyToSystem[family], signature);
         }
 
         void EntityDestroyed(Entity entity);
 
         void EntitySignatureChanged(Entity entity, Signature entitySiganture);
 
+        // a single component type was added to / removed from the entity, only the systems requiring it are re-checked
+        void EntityComponentChanged(Entity entity, ComponentType type, const Signature& entitySignature);
+
+        // bulk versions, every system is visited once for the whole batch
+        // entities and signatures are parallel arrays
+        void EntitiesDestroyed(const std::vector<Entity>& entities);
+
+        void EntitiesSignatureChanged(const std::vector<Entity>& entities, const std::vector<Signature>& signatures);
+
+        // every entity was destroyed at once, the systems keep their signatures
+        void AllEntitiesDestroyed();
+
+        // every entity has the same signature, each system is matched once for the whole batch
+        void EntitiesSignatureChanged(const std::vector<Entity>& entities, const Signature& signature);
+
+        // the same component type was added to / removed from every entity
+        void EntitiesComponentChanged(const std::vector<Entity>& entities, ComponentType type, const std::vector<Signature>& signatures);
+
+        // sorts the entity list of the first system that lost its ascending entity order
+        // false when every list already is in order
+        bool SortNextEntityList();
+
     private:
 
-        std::unordered_map<std::string, Signature> aSignatures{};
+        static constexpr size_t INVALID_SYSTEM = static_cast<size_t>(-1);
+
+        // stores the signature and moves the system between the component buckets
+        void SetSignature(size_t system, const Signature& signature);
+
+        inline bool IsRegistered(size_t family) const
+        {
+            return family < aFamilyToSystem.size() && aFamilyToSystem[family] != INVALID_SYSTEM;
+        }
+
+        // SystemFamily id -> index into aSystems / aSignatures
+        std::vector<size_t> aFamilyToSystem{};
+
+        // parallel arrays, in registration order
+        std::vector<Signature> aSignatures{};
+
+        std::vector<std::shared_ptr<ECSSystem>> aSystems{};
+
+        // ComponentType -> index of the systems whose signature contains it
+        std::array<std::vector<size_t>, MAX_COMPONENTS> aComponentToSystems{};
 
-        std::unordered_map<std::string, std::shared_ptr<ECSSystem>> aSystems{};
+        // systems with an empty signature match any entity, they are re-checked on every change
+        std::vector<size_t> aUnfilteredSystems{};
 
     };
 }
@@ -0,0 +1,52 @@
+/*!
+\file   TypeFamily.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Hands out small dense integer ids per C++ type, separately for every family (components, systems).
+
+The id of a type is assigned the first time it is requested and stays the same for the whole run, so it can be
+used directly as an index into flat vectors. This replaces building a std::string from typeid(T).name() and
+hashing it into an unordered_map on every component / system lookup.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace Uma_ECS
+{
+    template<typename Family>
+    class TypeFamily
+    {
+    public:
+        template<typename T>
+        static size_t GetId()
+        {
+            // one static per T, initialised once on the first call
+            static const size_t id = sNextId++;
+            return id;
+        }
+
+        static size_t Count() { return sNextId; }
+
+    private:
+        static inline size_t sNextId = 0;
+    };
+
+    struct ComponentFamilyTag {};
+    struct SystemFamilyTag {};
+
+    using ComponentFamily = TypeFamily<ComponentFamilyTag>;
+    using SystemFamily = TypeFamily<SystemFamilyTag>;
+}
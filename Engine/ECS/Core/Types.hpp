@@ -12,10 +12,15 @@
 \brief
 Defines core type aliases and constants for the Uma_ECS namespace.
 
-Establishes Entity as unsigned int with MAX_ENTITIES capacity of 11,000.
-ComponentType as unsigned int with MAX_COMPONENTS limit of 32 types.
-Signature as std::bitset<MAX_COMPONENTS> for efficient component presence tracking.
+Establishes Entity as unsigned int, with INVALID_ENTITY reserved and no fixed entity capacity.
+EntityHandle pairs an Entity with its EntityGeneration so handles to destroyed (and reused) ids can be rejected.
+ChangeTick is the world tick used by the per-component change tracking.
+ComponentType as unsigned int with MAX_COMPONENTS limit of 128 types.
+Signature as BitSignature<MAX_COMPONENTS> (Signature.hpp) for word-wise component presence tracking.
 Includes ECSErrorCode enum for error handling in debug and release builds.
+StorageMode selects between per-type component pools and archetype chunk storage.
+HotData is the hot / cold split hook, specialised next to a component that keeps its runtime fields in a packed mirror.
+DoubleBuffered opts a component into a read-only previous buffer published once per frame.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -25,7 +30,7 @@ All rights reserved.
 
 // this whole header file is just to declare the types we are using for Uma_ECS
 
-#include <bitset>
+#include "Signature.hpp"
 
 namespace Uma_ECS
 {
@@ -42,14 +47,66 @@ namespace Uma_ECS
     
     // Uma_ECS
     using Entity = unsigned int;
-    const Entity MAX_ENTITIES = 11000;
+    // entity storage grows with the live entity count, ids are only bounded by the Entity type
+    const Entity INVALID_ENTITY = static_cast<Entity>(-1);
+    const Entity MAX_ENTITIES = INVALID_ENTITY;
+
+    // bumped every time an entity id is destroyed, a handle only matches the generation it was made with
+    // define ECS_NO_GENERATION_CHECK to compile the generations out, handles then only check that the id is alive
+    using EntityGeneration = unsigned int;
+
+    struct EntityHandle
+    {
+        Entity entity = INVALID_ENTITY;
+        EntityGeneration generation = 0;
+
+        friend inline bool operator==(const EntityHandle& lhs, const EntityHandle& rhs)
+        {
+            return lhs.entity == rhs.entity && lhs.generation == rhs.generation;
+        }
+        friend inline bool operator!=(const EntityHandle& lhs, const EntityHandle& rhs) { return !(lhs == rhs); }
+    };
+
+    // world tick stamped on a component when it is added or written through a mutable accessor
+    // the Coordinator advances it, Changed<T>{ since } matches the components stamped after since
+    using ChangeTick = unsigned int;
+
     using ComponentType = unsigned int;
-    const ComponentType MAX_COMPONENTS = 32;
+    // signatures are compared a 64-bit word at a time, so raising this only adds a word per 64 types
+    const ComponentType MAX_COMPONENTS = 128;
 
 		// for component that requires layer
 		// eg collider and renderer
 		using LayerMask = unsigned int;
 		
 		// this is to track which components an entity has 
-		using Signature = std::bitset<MAX_COMPONENTS>;
+		using Signature = BitSignature<MAX_COMPONENTS>;
+
+		// how the coordinator stores component data
+		// Pooled    : one packed ComponentArray per component type (default)
+		// Archetype : entities with the same signature share chunks with their columns side by side
+		enum class StorageMode
+		{
+				SM_Pooled = 0,
+				SM_Archetype
+		};
+
+    // hot / cold split of a component, type is the trivially copyable runtime half the pool keeps in a packed array
+    // parallel to the components, Sync refreshes it from the authoring half, see ComponentArray::SyncHot
+    // an optional static Validate(const T&) is called when a component enters the pool, to report what Sync can't hold
+    // the primary template means the component isn't split
+    template<typename T>
+    struct HotData
+    {
+        using type = void;
+    };
+
+    // double buffered components keep a read-only copy of their last published state in a packed array parallel to
+    // the components, readers (rendering, AI) use it while writers update the current buffer
+    // see ComponentArray::SwapBuffers, specialise with value = true next to the component
+    template<typename T>
+    struct DoubleBuffered
+    {
+        static constexpr bool value = false;
+    };
 }
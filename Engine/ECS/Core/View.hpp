@@ -0,0 +1,235 @@
+/*!
+\file   View.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements ComponentView, a multi-component query over the per-type component pools.
+
+A view over <Ts...> walks the packed entity list of the smallest requested pool and probes the others through their
+sparse index, skipping disabled entities and entities owning an excluded type. A Changed filter also skips entities
+whose listed components weren't written after a given tick. Iterating yields std::tuple<Entity, Ts&...>, Each(func)
+does the same walk without the iterator. Adding or removing components of the viewed types invalidates the view.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "Types.hpp"
+#include "ComponentArray.hpp"
+
+#include <array>
+#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+namespace Uma_ECS
+{
+    // list of component types an entity must not have, passed to Coordinator::View
+    // eg. coordinator.View<Transform, RigidBody>(Exclude<Enemy>{})
+    template<typename... Es>
+    struct Exclude {};
+
+    // true if T is one of Us
+    template<typename T, typename... Us>
+    inline constexpr bool IsOneOf = (std::is_same_v<T, Us> || ...);
+
+    // keeps only the entities where at least one of Cs was added / written after since, passed to Coordinator::View
+    // eg. coordinator.View<Collider, Transform>(Changed<Collider, Transform>{ mLastTick })
+    template<typename... Cs>
+    struct Changed
+    {
+        static_assert(sizeof...(Cs) > 0, "Error : Changed needs at least one component type.");
+
+        ChangeTick since = 0;
+    };
+
+    template<typename... Ts>
+    class ComponentView
+    {
+        static_assert(sizeof...(Ts) > 0, "Error : A view needs at least one component type.");
+
+    public:
+        using value_type = std::tuple<Entity, Ts&...>;
+
+        // which of Ts / which other pools a Changed filter looks at
+        struct ChangeFilter
+        {
+            bool active = false;
+            std::array<bool, sizeof...(Ts)> aTracked{};
+            std::vector<const BaseComponentArray*> aOthers;
+            ChangeTick since = 0;
+        };
+
+        // disabled is the EntityManager's per entity flags, nullptr when no entity is disabled
+        ComponentView(std::tuple<ComponentArray<Ts>*...> pools, std::vector<const BaseComponentArray*> excludes,
+            const std::vector<uint8_t>* disabled, ChangeFilter changed = {})
+            : aPools(pools), aExcludes(std::move(excludes)), pDisabled(disabled), mChanged(std::move(changed))
+        {
+            // drive the iteration with the smallest pool
+            std::array<const std::vector<Entity>*, sizeof...(Ts)> entityLists{};
+            std::array<size_t, sizeof...(Ts)> sizes{};
+
+            std::apply([&](auto*... pool)
+                {
+                    size_t i = 0;
+                    ((entityLists[i] = &pool->GetEntities(), sizes[i] = pool->Size(), ++i), ...);
+                }, aPools);
+
+            size_t smallest = 0;
+            for (size_t i = 1; i < sizes.size(); ++i)
+            {
+                if (sizes[i] < sizes[smallest]) smallest = i;
+            }
+
+            mLead = smallest;
+            pLead = entityLists[smallest];
+        }
+
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::tuple<Entity, Ts&...>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            Iterator(const ComponentView* view, size_t index)
+                : pView(view), mIndex(index), mEnd(view->pLead->size())
+            {
+            }
+
+            value_type operator*() const
+            {
+                return std::apply([this](Ts*... components) { return value_type{ mEntity, *components... }; }, aCurrent);
+            }
+
+            // moves forward until the entity at mIndex matches the view, caching its components
+            Iterator& operator++()
+            {
+                while (++mIndex < mEnd && !pView->Fetch(mIndex, mEntity, aCurrent))
+                {
+                }
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const Iterator& other) const { return mIndex == other.mIndex; }
+            bool operator!=(const Iterator& other) const { return mIndex != other.mIndex; }
+
+        private:
+            const ComponentView* pView = nullptr;
+            size_t mIndex = 0;
+            size_t mEnd = 0; // pool size when the iterator was made, the view must not be modified while iterating
+
+            Entity mEntity = INVALID_ENTITY;
+            std::tuple<Ts*...> aCurrent{};
+        };
+
+        Iterator begin() const
+        {
+            // starts one before the first slot, ++ wraps it to 0 and skips to the first match
+            Iterator it(this, static_cast<size_t>(-1));
+            return ++it;
+        }
+
+        Iterator end() const { return Iterator(this, pLead->size()); }
+
+        // calls func(Entity, Ts&...) for every matching entity
+        template<typename Func>
+        void Each(Func&& func) const
+        {
+            std::tuple<Ts*...> components{};
+            Entity entity = INVALID_ENTITY;
+
+            for (size_t i = 0, end = pLead->size(); i < end; ++i)
+            {
+                if (!Fetch(i, entity, components)) continue;
+
+                std::apply([&func, entity](Ts*... c) { func(entity, *c...); }, components);
+            }
+        }
+
+        // upper bound of the number of matching entities (size of the driving pool)
+        inline size_t SizeHint() const { return pLead->size(); }
+
+    private:
+        // looks the entity at index of the driving pool up in every other pool
+        // false if the entity is disabled, one is missing, an excluded component is present or none of the Changed
+        // components changed
+        bool Fetch(size_t index, Entity& entity, std::tuple<Ts*...>& out) const
+        {
+            entity = (*pLead)[index];
+
+            if (pDisabled && entity < pDisabled->size() && (*pDisabled)[entity]) return false;
+
+            for (const BaseComponentArray* exclude : aExcludes)
+            {
+                if (exclude->Has(entity)) return false;
+            }
+
+            if (mChanged.active && !AnyChanged(index, entity, std::index_sequence_for<Ts...>{})) return false;
+
+            return FetchAll(index, entity, out, std::index_sequence_for<Ts...>{});
+        }
+
+        // the viewed pools are checked without a virtual call, the driving one by index
+        template<size_t... Is>
+        bool AnyChanged(size_t index, Entity entity, std::index_sequence<Is...>) const
+        {
+            bool changed = ((mChanged.aTracked[Is] && (Is == mLead
+                ? std::get<Is>(aPools)->GetChangeTickAt(index) > mChanged.since
+                : std::get<Is>(aPools)->ComponentArray<Ts>::ChangedSince(entity, mChanged.since))) || ...);
+
+            if (changed) return true;
+
+            for (const BaseComponentArray* pool : mChanged.aOthers)
+            {
+                if (pool->ChangedSince(entity, mChanged.since)) return true;
+            }
+
+            return false;
+        }
+
+        template<size_t... Is>
+        bool FetchAll(size_t index, Entity entity, std::tuple<Ts*...>& out, std::index_sequence<Is...>) const
+        {
+            // the driving pool is read by index, stops at the first pool that doesn't contain the entity
+            return ((std::get<Is>(out) = (Is == mLead)
+                ? &std::get<Is>(aPools)->GetComponentAt(index)
+                : std::get<Is>(aPools)->TryGetData(entity)) && ...);
+        }
+
+        std::tuple<ComponentArray<Ts>*...> aPools;
+        std::vector<const BaseComponentArray*> aExcludes;
+
+        // nullptr while every entity is enabled
+        const std::vector<uint8_t>* pDisabled = nullptr;
+
+        // inactive when the view isn't filtered on changes
+        ChangeFilter mChanged;
+
+        size_t mLead = 0; // position in Ts of the driving pool
+        const std::vector<Entity>* pLead = nullptr;
+    };
+}
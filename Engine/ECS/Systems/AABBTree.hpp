@@ -0,0 +1,751 @@
+/*!
+\file   AABBTree.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements AABBTree, a bounding volume hierarchy over axis-aligned boxes, and AABBTreeBroadphase, the CollisionSystem
+broadphase built from two of them.
+
+Leaves hold a fat box, the collider's bounds grown by a margin, so a body moving a little inside it costs nothing.
+A body leaving its fat box gets a new one: refitted in place when it still fits in its parent (the ancestors can only
+shrink), removed and re-inserted otherwise. Inserts pick the sibling with the cheapest perimeter growth, the
+ancestors are then refitted and rotated where swapping a child with a grandchild shrinks the tree, a tree balanced on
+its boxes' perimeters rather than its height.
+A tree can also be built top down in one go (median split on the longest axis), for a set that doesn't change.
+
+AABBTreeBroadphase keeps the moving colliders in a dynamic tree and the static ones (every active shape is
+Environment, never moved by the resolution) in a separate static tree with exact boxes, built top down when the set
+of static colliders changes, in practice once at scene load. The pairs whose fat boxes overlap are kept across
+frames, only the colliders that left their fat box query both trees for new ones, a pair of static colliders is never
+generated. GatherPairs hands out the kept pairs whose exact bounds overlap. Walls of very different sizes cost nothing
+extra, unlike a grid where a large floor covers many cells.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "../Core/Types.hpp"
+#include "../Components/Collider.h"
+#include "BroadphasePairs.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <cfloat>
+
+namespace Uma_ECS
+{
+    inline BoundingBox UnionBox(const BoundingBox& a, const BoundingBox& b)
+    {
+        return BoundingBox{
+            Vec2{ std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y) },
+            Vec2{ std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y) }
+        };
+    }
+
+    // true if inner lies inside outer
+    inline bool ContainsBox(const BoundingBox& outer, const BoundingBox& inner)
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y
+            && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+    }
+
+    // touching boxes overlap, same as the narrow phase's test
+    inline bool OverlapsBox(const BoundingBox& a, const BoundingBox& b)
+    {
+        return !(a.max.x < b.min.x || a.min.x > b.max.x || a.max.y < b.min.y || a.min.y > b.max.y);
+    }
+
+    inline float Perimeter(const BoundingBox& box)
+    {
+        return 2.0f * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+    }
+
+    class AABBTree
+    {
+    public:
+        using NodeId = uint32_t;
+        static constexpr NodeId NULL_NODE = UINT32_MAX;
+
+        static constexpr float DEFAULT_FAT_MARGIN = 4.0f;
+
+        explicit AABBTree(float fatMargin = DEFAULT_FAT_MARGIN) : mFatMargin(fatMargin) {}
+
+        // margin the leaves' boxes are grown by, used by the next inserts / moves
+        inline void SetFatMargin(float fatMargin) { mFatMargin = fatMargin; }
+        inline float GetFatMargin() const { return mFatMargin; }
+
+        // adds a leaf for entity, returns its node
+        NodeId CreateProxy(Entity entity, const BoundingBox& box)
+        {
+            NodeId leaf = AllocateNode();
+            aNodes[leaf].box = Fatten(box);
+            aNodes[leaf].entity = entity;
+            aNodes[leaf].height = 0;
+            ++mLeafCount;
+
+            InsertLeaf(leaf);
+            return leaf;
+        }
+
+        void DestroyProxy(NodeId leaf)
+        {
+            assert(aNodes[leaf].IsLeaf() && "Error : Only a leaf of an AABB tree can be destroyed.");
+
+            RemoveLeaf(leaf);
+            FreeNode(leaf);
+            --mLeafCount;
+        }
+
+        // returns true if the leaf's fat box had to change
+        bool MoveProxy(NodeId leaf, const BoundingBox& box)
+        {
+            if (ContainsBox(aNodes[leaf].box, box)) return false;
+
+            BoundingBox fat = Fatten(box);
+            NodeId parent = aNodes[leaf].parent;
+
+            if (parent != NULL_NODE && ContainsBox(aNodes[parent].box, fat))
+            {
+                // still inside its parent, the ancestors only shrink, refit them upwards
+                aNodes[leaf].box = fat;
+
+                for (NodeId index = parent; index != NULL_NODE; index = aNodes[index].parent)
+                {
+                    BoundingBox refit = UnionBox(aNodes[aNodes[index].child1].box, aNodes[aNodes[index].child2].box);
+                    if (ContainsBox(refit, aNodes[index].box)) break; // unchanged from here up
+
+                    aNodes[index].box = refit;
+                }
+
+                return true;
+            }
+
+            RemoveLeaf(leaf);
+            aNodes[leaf].box = fat;
+            InsertLeaf(leaf);
+            return true;
+        }
+
+        inline const BoundingBox& GetFatBox(NodeId leaf) const { return aNodes[leaf].box; }
+        inline Entity GetEntity(NodeId leaf) const { return aNodes[leaf].entity; }
+
+        // calls func(Entity, NodeId) for every leaf whose box overlaps box
+        template<typename Func>
+        void Query(const BoundingBox& box, Func&& func) const
+        {
+            if (mRoot == NULL_NODE) return;
+
+            aStack.clear();
+            aStack.push_back(mRoot);
+
+            while (!aStack.empty())
+            {
+                NodeId index = aStack.back();
+                aStack.pop_back();
+
+                const Node& node = aNodes[index];
+                if (!OverlapsBox(node.box, box)) continue;
+
+                if (node.IsLeaf())
+                {
+                    func(node.entity, index);
+                }
+                else
+                {
+                    aStack.push_back(node.child1);
+                    aStack.push_back(node.child2);
+                }
+            }
+        }
+
+        // replaces the tree by one built top down over the items, exact boxes (no margin)
+        // returns the leaf of every item, in the items' order
+        std::vector<NodeId> Build(const std::vector<std::pair<Entity, BoundingBox>>& items)
+        {
+            Clear();
+
+            std::vector<NodeId> leaves;
+            leaves.reserve(items.size());
+
+            for (const auto& [entity, box] : items)
+            {
+                NodeId leaf = AllocateNode();
+                aNodes[leaf].box = box;
+                aNodes[leaf].entity = entity;
+                aNodes[leaf].height = 0;
+                leaves.push_back(leaf);
+                ++mLeafCount;
+            }
+
+            if (!leaves.empty())
+            {
+                std::vector<NodeId> order = leaves;
+                mRoot = BuildRange(order, 0, order.size());
+                aNodes[mRoot].parent = NULL_NODE;
+            }
+
+            return leaves;
+        }
+
+        // the memory is kept
+        void Clear()
+        {
+            aNodes.clear();
+            mRoot = NULL_NODE;
+            mFreeList = NULL_NODE;
+            mLeafCount = 0;
+        }
+
+        inline size_t LeafCount() const { return mLeafCount; }
+
+        inline int Height() const { return mRoot == NULL_NODE ? 0 : aNodes[mRoot].height; }
+
+        // sum of the internal nodes' perimeters over the root's, lower is a tighter tree
+        float AreaRatio() const
+        {
+            if (mRoot == NULL_NODE) return 0.0f;
+
+            float total = 0.0f;
+            for (const Node& node : aNodes)
+            {
+                if (node.height > 0) total += Perimeter(node.box);
+            }
+
+            float root = Perimeter(aNodes[mRoot].box);
+            return root > 0.0f ? total / root : 0.0f;
+        }
+
+    private:
+        struct Node
+        {
+            BoundingBox box{};
+            NodeId parent = NULL_NODE; // next free node while on the free list
+            NodeId child1 = NULL_NODE;
+            NodeId child2 = NULL_NODE;
+            int height = -1; // 0 for a leaf, -1 while free
+            Entity entity = INVALID_ENTITY;
+
+            inline bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        inline BoundingBox Fatten(const BoundingBox& box) const
+        {
+            return BoundingBox{
+                Vec2{ box.min.x - mFatMargin, box.min.y - mFatMargin },
+                Vec2{ box.max.x + mFatMargin, box.max.y + mFatMargin }
+            };
+        }
+
+        NodeId AllocateNode()
+        {
+            NodeId index;
+            if (mFreeList != NULL_NODE)
+            {
+                index = mFreeList;
+                mFreeList = aNodes[index].parent;
+            }
+            else
+            {
+                index = static_cast<NodeId>(aNodes.size());
+                aNodes.emplace_back();
+            }
+
+            aNodes[index] = Node{};
+            return index;
+        }
+
+        void FreeNode(NodeId index)
+        {
+            aNodes[index].parent = mFreeList;
+            aNodes[index].height = -1;
+            mFreeList = index;
+        }
+
+        void InsertLeaf(NodeId leaf)
+        {
+            if (mRoot == NULL_NODE)
+            {
+                mRoot = leaf;
+                aNodes[leaf].parent = NULL_NODE;
+                return;
+            }
+
+            // walk down to the sibling whose box grows the least, the cost of a subtree is its perimeter growth
+            // plus what every ancestor grows by on the way
+            BoundingBox leafBox = aNodes[leaf].box;
+            NodeId index = mRoot;
+
+            while (!aNodes[index].IsLeaf())
+            {
+                const Node& node = aNodes[index];
+
+                float area = Perimeter(node.box);
+                float combinedArea = Perimeter(UnionBox(node.box, leafBox));
+
+                // a new parent of this node and the leaf
+                float cost = 2.0f * combinedArea;
+                float inheritanceCost = 2.0f * (combinedArea - area);
+
+                auto childCost = [&](NodeId child)
+                    {
+                        const Node& c = aNodes[child];
+                        float grown = Perimeter(UnionBox(leafBox, c.box));
+                        return (c.IsLeaf() ? grown : grown - Perimeter(c.box)) + inheritanceCost;
+                    };
+
+                float cost1 = childCost(node.child1);
+                float cost2 = childCost(node.child2);
+
+                if (cost < cost1 && cost < cost2) break;
+
+                index = cost1 < cost2 ? node.child1 : node.child2;
+            }
+
+            NodeId sibling = index;
+            NodeId oldParent = aNodes[sibling].parent;
+
+            NodeId newParent = AllocateNode();
+            aNodes[newParent].parent = oldParent;
+            aNodes[newParent].box = UnionBox(leafBox, aNodes[sibling].box);
+            aNodes[newParent].height = aNodes[sibling].height + 1;
+            aNodes[newParent].child1 = sibling;
+            aNodes[newParent].child2 = leaf;
+            aNodes[sibling].parent = newParent;
+            aNodes[leaf].parent = newParent;
+
+            if (oldParent != NULL_NODE)
+            {
+                if (aNodes[oldParent].child1 == sibling) aNodes[oldParent].child1 = newParent;
+                else aNodes[oldParent].child2 = newParent;
+            }
+            else
+            {
+                mRoot = newParent;
+            }
+
+            RefitAndRotate(aNodes[leaf].parent);
+        }
+
+        void RemoveLeaf(NodeId leaf)
+        {
+            if (leaf == mRoot)
+            {
+                mRoot = NULL_NODE;
+                return;
+            }
+
+            NodeId parent = aNodes[leaf].parent;
+            NodeId grandParent = aNodes[parent].parent;
+            NodeId sibling = aNodes[parent].child1 == leaf ? aNodes[parent].child2 : aNodes[parent].child1;
+
+            // the sibling takes the parent's place
+            if (grandParent != NULL_NODE)
+            {
+                if (aNodes[grandParent].child1 == parent) aNodes[grandParent].child1 = sibling;
+                else aNodes[grandParent].child2 = sibling;
+
+                aNodes[sibling].parent = grandParent;
+                FreeNode(parent);
+
+                RefitAndRotate(grandParent);
+            }
+            else
+            {
+                mRoot = sibling;
+                aNodes[sibling].parent = NULL_NODE;
+                FreeNode(parent);
+            }
+        }
+
+        // walks up from index, rotating below every ancestor where it shrinks the tree and refitting its box and height
+        void RefitAndRotate(NodeId index)
+        {
+            while (index != NULL_NODE)
+            {
+                Rotate(index);
+
+                Node& node = aNodes[index];
+                const Node& child1 = aNodes[node.child1];
+                const Node& child2 = aNodes[node.child2];
+
+                node.height = 1 + std::max(child1.height, child2.height);
+                node.box = UnionBox(child1.box, child2.box);
+
+                index = node.parent;
+            }
+        }
+
+        // swaps a child of iA (up) with a grandchild under iA's other child (parent), refits parent
+        void SwapDown(NodeId iA, NodeId up, NodeId parent, NodeId down)
+        {
+            Node& A = aNodes[iA];
+            Node& P = aNodes[parent];
+
+            if (A.child1 == up) A.child1 = down;
+            else A.child2 = down;
+
+            if (P.child1 == down) P.child1 = up;
+            else P.child2 = up;
+
+            aNodes[down].parent = iA;
+            aNodes[up].parent = parent;
+
+            P.box = UnionBox(aNodes[P.child1].box, aNodes[P.child2].box);
+            P.height = 1 + std::max(aNodes[P.child1].height, aNodes[P.child2].height);
+        }
+
+        // swaps one child of iA with a grandchild if that shrinks the perimeter of the child's subtree, the
+        // rotation that shrinks it the most is taken. Balancing on perimeter instead of height keeps the tree
+        // tight where the bodies are, a height balanced tree groups bodies far apart to even out the depths
+        void Rotate(NodeId iA)
+        {
+            const Node& A = aNodes[iA];
+            if (A.height < 2) return;
+
+            NodeId iB = A.child1;
+            NodeId iC = A.child2;
+            const Node& B = aNodes[iB];
+            const Node& C = aNodes[iC];
+
+            // only the box of the child taking the swapped node in changes, the cost is its perimeter growth
+            float bestCost = 0.0f;
+            NodeId bestUp = NULL_NODE, bestParent = NULL_NODE, bestDown = NULL_NODE;
+
+            auto consider = [&](NodeId up, NodeId parent, NodeId down, NodeId kept)
+                {
+                    float cost = Perimeter(UnionBox(aNodes[up].box, aNodes[kept].box)) - Perimeter(aNodes[parent].box);
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestUp = up;
+                        bestParent = parent;
+                        bestDown = down;
+                    }
+                };
+
+            if (!C.IsLeaf())
+            {
+                consider(iB, iC, C.child1, C.child2);
+                consider(iB, iC, C.child2, C.child1);
+            }
+
+            if (!B.IsLeaf())
+            {
+                consider(iC, iB, B.child1, B.child2);
+                consider(iC, iB, B.child2, B.child1);
+            }
+
+            if (bestUp != NULL_NODE)
+            {
+                SwapDown(iA, bestUp, bestParent, bestDown);
+            }
+        }
+
+        // builds a subtree over order[begin, end), split at the median centre on the longest axis
+        NodeId BuildRange(std::vector<NodeId>& order, size_t begin, size_t end)
+        {
+            if (end - begin == 1) return order[begin];
+
+            BoundingBox centres{ Vec2{ FLT_MAX, FLT_MAX }, Vec2{ -FLT_MAX, -FLT_MAX } };
+            for (size_t i = begin; i < end; ++i)
+            {
+                Vec2 centre = (aNodes[order[i]].box.min + aNodes[order[i]].box.max) * 0.5f;
+                centres = UnionBox(centres, BoundingBox{ centre, centre });
+            }
+
+            bool splitX = (centres.max.x - centres.min.x) >= (centres.max.y - centres.min.y);
+            size_t middle = begin + (end - begin) / 2;
+
+            std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                [&](NodeId a, NodeId b)
+                {
+                    const BoundingBox& boxA = aNodes[a].box;
+                    const BoundingBox& boxB = aNodes[b].box;
+                    return splitX ? (boxA.min.x + boxA.max.x) < (boxB.min.x + boxB.max.x)
+                        : (boxA.min.y + boxA.max.y) < (boxB.min.y + boxB.max.y);
+                });
+
+            NodeId child1 = BuildRange(order, begin, middle);
+            NodeId child2 = BuildRange(order, middle, end);
+
+            NodeId node = AllocateNode();
+            aNodes[node].child1 = child1;
+            aNodes[node].child2 = child2;
+            aNodes[node].box = UnionBox(aNodes[child1].box, aNodes[child2].box);
+            aNodes[node].height = 1 + std::max(aNodes[child1].height, aNodes[child2].height);
+            aNodes[child1].parent = node;
+            aNodes[child2].parent = node;
+
+            return node;
+        }
+
+        std::vector<Node> aNodes;
+        NodeId mRoot = NULL_NODE;
+        NodeId mFreeList = NULL_NODE;
+        size_t mLeafCount = 0;
+
+        float mFatMargin = DEFAULT_FAT_MARGIN;
+
+        // traversal stack of Query, reused
+        mutable std::vector<NodeId> aStack;
+    };
+
+    class AABBTreeBroadphase
+    {
+    public:
+        // margin of the dynamic tree's fat boxes, a larger one re-inserts less often but gives looser pairs
+        inline void SetFatMargin(float fatMargin) { mDynamicTree.SetFatMargin(fatMargin); }
+        inline float GetFatMargin() const { return mDynamicTree.GetFatMargin(); }
+
+        // starts a frame, the entities not updated until the next Sweep are dropped
+        inline void BeginFrame() { ++mFrame; }
+
+        // adds the entity or moves it to box, a static entity goes to the static tree
+        void Update(Entity entity, const BoundingBox& box, bool isStatic = false)
+        {
+            if (aEntries.size() <= entity)
+            {
+                aEntries.resize(static_cast<size_t>(entity) + 1);
+            }
+
+            Entry& entry = aEntries[entity];
+            entry.frame = mFrame;
+
+            if (entry.inSet && entry.isStatic != isStatic)
+            {
+                // changed tree
+                Remove(entity);
+            }
+
+            if (!entry.inSet)
+            {
+                entry.inSet = true;
+                entry.isStatic = isStatic;
+                entry.box = box;
+                entry.slot = static_cast<Entity>(aTracked.size());
+                aTracked.push_back(entity);
+
+                if (isStatic)
+                {
+                    entry.fatBox = box;
+                    mStaticDirty = true;
+                }
+                else
+                {
+                    entry.node = mDynamicTree.CreateProxy(entity, box);
+                    entry.fatBox = mDynamicTree.GetFatBox(entry.node);
+                    MarkMoved(entity);
+                }
+
+                return;
+            }
+
+            if (isStatic)
+            {
+                // a wall moved by a script, rare, the static tree is rebuilt
+                if (entry.box.min.x != box.min.x || entry.box.min.y != box.min.y
+                    || entry.box.max.x != box.max.x || entry.box.max.y != box.max.y)
+                {
+                    entry.fatBox = box;
+                    mStaticDirty = true;
+                }
+            }
+            else if (mDynamicTree.MoveProxy(entry.node, box))
+            {
+                entry.fatBox = mDynamicTree.GetFatBox(entry.node);
+                MarkMoved(entity);
+            }
+
+            entry.box = box;
+        }
+
+        void Remove(Entity entity)
+        {
+            if (!Contains(entity)) return;
+
+            Entry& entry = aEntries[entity];
+            if (entry.isStatic)
+            {
+                mStaticDirty = true;
+            }
+            else
+            {
+                mDynamicTree.DestroyProxy(entry.node);
+            }
+
+            entry.inSet = false;
+
+            // swap and pop
+            Entity last = aTracked.back();
+            aTracked[entry.slot] = last;
+            aEntries[last].slot = entry.slot;
+            aTracked.pop_back();
+        }
+
+        // drops the entities not updated since BeginFrame, rebuilds the static tree if its set changed and
+        // brings the pairs up to date: the ones whose fat boxes parted are dropped, the entities that left
+        // their fat box are queried for new ones
+        void Sweep()
+        {
+            for (size_t i = aTracked.size(); i-- > 0;)
+            {
+                Entity entity = aTracked[i];
+                if (aEntries[entity].frame != mFrame) Remove(entity);
+            }
+
+            if (mStaticDirty)
+            {
+                RebuildStaticTree();
+
+                // every dynamic entity may now touch a wall it didn't
+                for (Entity entity : aTracked)
+                {
+                    if (!aEntries[entity].isStatic) MarkMoved(entity);
+                }
+            }
+
+            PrunePairs();
+
+            for (Entity entity : aMoved)
+            {
+                Entry& entry = aEntries[entity];
+                entry.moved = false;
+
+                // removed after it moved
+                if (!entry.inSet || entry.isStatic) continue;
+
+                mDynamicTree.Query(entry.fatBox, [&](Entity other, AABBTree::NodeId)
+                    {
+                        if (other != entity) aPairs.Insert(MakePairKey(entity, other));
+                    });
+
+                mStaticTree.Query(entry.fatBox, [&](Entity other, AABBTree::NodeId)
+                    {
+                        aPairs.Insert(MakePairKey(entity, other));
+                    });
+            }
+
+            aMoved.clear();
+        }
+
+        // appends the dynamic / dynamic and dynamic / static pairs whose bounds overlap, in no particular order
+        // returns the pairs whose fat boxes overlap the broadphase keeps
+        size_t GatherPairs(std::vector<PairKey>& out) const
+        {
+            for (PairKey pair : aPairs.GetPairs())
+            {
+                if (OverlapsBox(aEntries[PairFirst(pair)].box, aEntries[PairSecond(pair)].box)) out.push_back(pair);
+            }
+
+            return aPairs.Size();
+        }
+
+        inline bool Contains(Entity entity) const
+        {
+            return entity < aEntries.size() && aEntries[entity].inSet;
+        }
+
+        // empties both trees, the memory is kept
+        void Clear()
+        {
+            mDynamicTree.Clear();
+            mStaticTree.Clear();
+
+            aEntries.clear();
+            aTracked.clear();
+            aMoved.clear();
+            aPairs.Clear();
+            mStaticDirty = false;
+        }
+
+        inline size_t EntityCount() const { return aTracked.size(); }
+
+        inline const AABBTree& GetDynamicTree() const { return mDynamicTree; }
+        inline const AABBTree& GetStaticTree() const { return mStaticTree; }
+
+        // times the static tree was built, one per scene load in a scene whose walls don't move
+        inline size_t StaticBuildCount() const { return mStaticBuilds; }
+
+    private:
+        // per entity, indexed by entity id
+        struct Entry
+        {
+            BoundingBox box{}; // exact bounds of the last update
+            BoundingBox fatBox{}; // box of the leaf, the exact bounds for a static entity
+            AABBTree::NodeId node = AABBTree::NULL_NODE; // leaf in the dynamic tree
+            uint32_t frame = 0;
+            Entity slot = 0; // position in aTracked
+            bool inSet = false;
+            bool isStatic = false;
+            bool moved = false; // in aMoved
+        };
+
+        inline void MarkMoved(Entity entity)
+        {
+            if (aEntries[entity].moved) return;
+
+            aEntries[entity].moved = true;
+            aMoved.push_back(entity);
+        }
+
+        // drops the pairs whose fat boxes stopped overlapping or that lost an entity
+        // erasing swaps the last pair in, walking backwards visits every pair once
+        void PrunePairs()
+        {
+            const std::vector<PairKey>& pairs = aPairs.GetPairs();
+            for (size_t i = pairs.size(); i-- > 0;)
+            {
+                PairKey pair = pairs[i];
+                const Entry& a = aEntries[PairFirst(pair)];
+                const Entry& b = aEntries[PairSecond(pair)];
+
+                bool keep = a.inSet && b.inSet && !(a.isStatic && b.isStatic) && OverlapsBox(a.fatBox, b.fatBox);
+                if (!keep) aPairs.Erase(pair);
+            }
+        }
+
+        void RebuildStaticTree()
+        {
+            aStaticItems.clear();
+            for (Entity entity : aTracked)
+            {
+                if (aEntries[entity].isStatic) aStaticItems.emplace_back(entity, aEntries[entity].box);
+            }
+
+            mStaticTree.Build(aStaticItems);
+            mStaticDirty = false;
+            ++mStaticBuilds;
+        }
+
+        AABBTree mDynamicTree;
+        AABBTree mStaticTree{ 0.0f };
+
+        std::vector<Entry> aEntries;
+
+        // entities in either tree, for Sweep
+        std::vector<Entity> aTracked;
+
+        // dynamic entities to query at the next Sweep, new or out of their fat box
+        std::vector<Entity> aMoved;
+
+        // pairs whose fat boxes overlap, at least one of them dynamic
+        PairSet aPairs;
+
+        std::vector<std::pair<Entity, BoundingBox>> aStaticItems;
+        bool mStaticDirty = false;
+        size_t mStaticBuilds = 0;
+
+        uint32_t mFrame = 0;
+    };
+}
@@ -0,0 +1,223 @@
+/*!
+\file   BroadphasePairs.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Defines the candidate pair list the collision broadphase hands to the narrow phase.
+
+A pair is packed in one 64 bit key, the lower entity id in the high half, so sorting the keys orders the pairs by
+their first then second entity and equal pairs end up next to each other. The narrow phase walks the sorted list,
+every pair is tested and resolved once per frame in the same order whatever the broadphase's internal layout.
+A crowded grid gives tens of thousands of pairs a frame, SortPairs is a radix sort over the bits the entity ids
+actually use (three passes for ids under 2^16) instead of a comparison sort.
+PairSet is the flat set a broadphase keeps its persistent pairs in, an open-addressed table (linear probing, deletion
+by shifting the following entries back, no tombstones) over a packed list of the pairs for iteration.
+BroadphaseStats counts the pairs of the last update.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "../Core/Types.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace Uma_ECS
+{
+    using PairKey = uint64_t;
+
+    inline PairKey MakePairKey(Entity a, Entity b)
+    {
+        if (b < a) std::swap(a, b);
+        return (static_cast<PairKey>(a) << 32) | static_cast<PairKey>(b);
+    }
+
+    inline Entity PairFirst(PairKey key) { return static_cast<Entity>(key >> 32); }
+    inline Entity PairSecond(PairKey key) { return static_cast<Entity>(key & 0xFFFFFFFFull); }
+
+    // sorts the pairs in ascending key order, scratch is reused across calls
+    inline void SortPairs(std::vector<PairKey>& pairs, std::vector<PairKey>& scratch)
+    {
+        constexpr size_t RADIX_BITS = 11;
+        constexpr size_t RADIX = size_t(1) << RADIX_BITS;
+
+        // a comparison sort wins on short lists
+        if (pairs.size() < RADIX)
+        {
+            std::sort(pairs.begin(), pairs.end());
+            return;
+        }
+
+        // the second entity is the larger one, its width is enough for both halves
+        Entity maxEntity = 0;
+        for (PairKey key : pairs) maxEntity = std::max(maxEntity, PairSecond(key));
+
+        const unsigned bits = static_cast<unsigned>(std::bit_width(maxEntity));
+
+        // both ids side by side in 2 * bits, same order as the full key
+        auto compact = [bits](PairKey key)
+            {
+                return (static_cast<uint64_t>(PairFirst(key)) << bits) | PairSecond(key);
+            };
+
+        scratch.resize(pairs.size());
+
+        std::array<size_t, RADIX> offsets;
+        for (unsigned shift = 0; shift < 2 * bits; shift += RADIX_BITS)
+        {
+            offsets.fill(0);
+            for (PairKey key : pairs) ++offsets[(compact(key) >> shift) & (RADIX - 1)];
+
+            size_t total = 0;
+            for (size_t& offset : offsets)
+            {
+                size_t count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for (PairKey key : pairs) scratch[offsets[(compact(key) >> shift) & (RADIX - 1)]++] = key;
+            pairs.swap(scratch);
+        }
+    }
+
+    class PairSet
+    {
+    public:
+        // false if the pair is already in
+        bool Insert(PairKey pair)
+        {
+            if ((aPairs.size() + 1) * 2 > aTable.size())
+            {
+                Grow();
+            }
+
+            size_t i = Home(pair);
+            for (; aTable[i].pair != EMPTY; i = (i + 1) & mMask)
+            {
+                if (aTable[i].pair == pair) return false;
+            }
+
+            aTable[i] = Slot{ pair, aPairs.size() };
+            aPairs.push_back(pair);
+            return true;
+        }
+
+        // false if the pair wasn't in
+        bool Erase(PairKey pair)
+        {
+            size_t i = Find(pair);
+            if (i == NOT_FOUND) return false;
+
+            // swap and pop in the packed list, the moved pair's slot follows it
+            size_t index = aTable[i].index;
+            PairKey last = aPairs.back();
+            aPairs[index] = last;
+            aPairs.pop_back();
+            if (last != pair) aTable[Find(last)].index = index;
+
+            // shift the entries of the probe run back over the hole
+            for (size_t j = (i + 1) & mMask; aTable[j].pair != EMPTY; j = (j + 1) & mMask)
+            {
+                size_t home = Home(aTable[j].pair);
+
+                // the entry at j may move to i only if its home isn't cyclically in (i, j]
+                bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+                if (!movable) continue;
+
+                aTable[i] = aTable[j];
+                i = j;
+            }
+
+            aTable[i].pair = EMPTY;
+            return true;
+        }
+
+        inline bool Contains(PairKey pair) const { return Find(pair) != NOT_FOUND; }
+
+        // every pair, in no particular order, invalidated by Insert / Erase
+        inline const std::vector<PairKey>& GetPairs() const { return aPairs; }
+
+        inline size_t Size() const { return aPairs.size(); }
+
+        // the memory is kept
+        void Clear()
+        {
+            for (Slot& slot : aTable) slot.pair = EMPTY;
+            aPairs.clear();
+        }
+
+    private:
+        static constexpr PairKey EMPTY = ~PairKey(0); // (INVALID_ENTITY, INVALID_ENTITY), never a pair
+        static constexpr size_t NOT_FOUND = ~size_t(0);
+
+        struct Slot
+        {
+            PairKey pair = EMPTY;
+            size_t index = 0; // position in aPairs
+        };
+
+        // multiplied by 2^64 / golden ratio, the top bits index the table
+        inline size_t Home(PairKey pair) const
+        {
+            return static_cast<size_t>((pair * 0x9E3779B97F4A7C15ull) >> mShift);
+        }
+
+        size_t Find(PairKey pair) const
+        {
+            if (aTable.empty()) return NOT_FOUND;
+
+            for (size_t i = Home(pair); aTable[i].pair != EMPTY; i = (i + 1) & mMask)
+            {
+                if (aTable[i].pair == pair) return i;
+            }
+
+            return NOT_FOUND;
+        }
+
+        void Grow()
+        {
+            size_t capacity = aTable.empty() ? 256 : aTable.size() * 2;
+
+            aTable.assign(capacity, Slot{});
+            mMask = capacity - 1;
+            mShift = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+
+            for (size_t index = 0; index < aPairs.size(); ++index)
+            {
+                size_t i = Home(aPairs[index]);
+                while (aTable[i].pair != EMPTY) i = (i + 1) & mMask;
+                aTable[i] = Slot{ aPairs[index], index };
+            }
+        }
+
+        std::vector<Slot> aTable;
+        size_t mMask = 0;
+        unsigned mShift = 64;
+
+        std::vector<PairKey> aPairs;
+    };
+
+    // pair counts of one broadphase update
+    struct BroadphaseStats
+    {
+        size_t testedPairs = 0;    // grid: pairs met while walking the cells, a pair sharing several cells counted in each
+                                   // sweep and prune: pairs overlapping on X
+                                   // AABB trees: pairs whose fat boxes overlap
+        size_t candidatePairs = 0; // distinct pairs handed to the narrow phase
+        size_t contacts = 0;       // shape pairs that passed the filters and overlapped
+    };
+}
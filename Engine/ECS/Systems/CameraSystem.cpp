@@ -12,8 +12,8 @@
 \brief
 Implements camera following behavior that tracks player position when followPlayer flag is enabled.
 
-Updates camera transform to match player transform position each frame by querying component arrays directly.
-Currently supports single camera setup with entity at index 0.
+Updates camera transform to match player transform position each frame by querying component views.
+Currently supports single camera setup, the first camera and the first player found are used.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -37,19 +37,22 @@ namespace Uma_ECS
         (void)dt;
         if (aEntities.size() == 0) return;
 
-        auto& pArray = pCoordinator->GetComponentArray<Player>();
-        auto& tfArray = pCoordinator->GetComponentArray<Transform>();
-        auto& camArray = pCoordinator->GetComponentArray<Camera>();
+        auto cameras = pCoordinator->View<Camera, Transform>();
+        auto players = pCoordinator->View<Player, Transform>();
 
         // one camera for now
-        Entity camera = aEntities[0];
-        auto& cam_tf = tfArray.GetData(camera);
-        auto& cam_c = camArray.GetData(camera);
+        auto cam_it = cameras.begin();
+        if (cam_it == cameras.end()) return;
+
+        auto [camera, cam_c, cam_tf] = *cam_it;
 
         if (cam_c.followPlayer)
         {
-            Entity player = pArray.GetEntity(0);
-            auto& player_tf = tfArray.GetData(player);
+            // first player only
+            auto player_it = players.begin();
+            if (player_it == players.end()) return;
+
+            auto [player, player_p, player_tf] = *player_it;
 
             cam_tf.position = player_tf.position;
         }
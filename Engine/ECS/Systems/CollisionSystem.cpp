@@ -12,8 +12,10 @@
 \brief
 Implements Unity-style collision detection and resolution using spatial hashing and contact normals.
 
-Updates axis-aligned bounding boxes from transform and collider data, then performs collision tests
-using spatial grid partitioning. Resolves collisions with velocity projection for smooth wall sliding.
+Updates the bounds in the packed ColliderHot records of the colliders whose Collider, Transform or Sprite changed,
+then finds candidate pairs with the selected broadphase (persistent spatial grid, sweep and prune or AABB trees),
+deduplicated and sorted by entity. The narrow phase tests their shape pairs in a ShapePairBatch and resolves the hits
+in pair order with velocity projection for smooth wall sliding.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -34,8 +36,20 @@ All rights reserved.
 
 void Uma_ECS::CollisionSystem::Update(float dt)
 {
+    (void)dt;
+
     UpdateBoundingBoxes();
-    UpdateCollision(dt);
+    UpdateCollision();
+}
+
+void Uma_ECS::CollisionSystem::SetBroadphaseMode(BroadphaseMode mode)
+{
+    if (mode == mBroadphaseMode) return;
+
+    mGrid.Clear();
+    mSweepAndPrune.Clear();
+    mAABBTree.Clear();
+    mBroadphaseMode = mode;
 }
 
 void Uma_ECS::CollisionSystem::UpdateBoundingBoxes()
@@ -43,40 +57,55 @@ void Uma_ECS::CollisionSystem::UpdateBoundingBoxes()
     if (aEntities.empty()) return;
 
     auto& cArray = gCoordinator->GetComponentArray<Collider>();
-    auto& tfArray = gCoordinator->GetComponentArray<Transform>();
     auto& sArray = gCoordinator->GetComponentArray<Sprite>();
+    auto& sharedSprites = gCoordinator->GetSharedComponentArray<Sprite>();
+
+    // the hot records of the colliders / sprites edited since the last frame pick up the authoring data
+    cArray.SyncHot();
+    sArray.SyncHot();
+
+    // only the colliders whose shapes, transform or sprite were written since the last update are recomputed
+    // static walls and floors keep their cached bounds
+    ChangeTick since = mLastBoundsTick;
+    mLastBoundsTick = gCoordinator->AdvanceChangeTick();
 
-    for (auto const& entity : aEntities)
+    for (auto [entity, c, tf, rb] : gCoordinator->View<Collider, Transform, RigidBody>(Changed<Collider, Transform, Sprite, Shared<Sprite>>{ since }))
     {
-        auto& c = cArray.GetData(entity);
-        auto& tf = tfArray.GetData(entity);
+        // only the hot half is read, the shape list stays out of the cache
+        ColliderHot& hot = cArray.GetHot(c);
 
-        // Ensure bounds array matches shapes array
-        if (c.bounds.size() != c.shapes.size())
+        // Get sprite size if available, an entity without its own sprite may use a shared one
+        Vec2 spriteSize{ 1.0f, 1.0f };
+        SpriteHot* s = sArray.TryGetHot(entity);
+        if (!s) s = sharedSprites.TryGetHot(entity);
+        if (s)
         {
-            c.bounds.resize(c.shapes.size());
+            if (s->texture)
+            {
+                spriteSize = s->texture->GetNativeSize();
+            }
         }
 
-        // Get sprite size if available
-        Vec2 spriteSize{ 1.0f, 1.0f };
-        if (sArray.Has(entity))
+        // the rare shapes past the inline ones keep their data in the authoring half, rebuilt here with their bounds
+        if (hot.HasOverflow())
         {
-            auto& s = sArray.GetData(entity);
-            if (s.texture)
+            c.overflow.resize(hot.count - INLINE_COLLIDER_SHAPES);
+            for (size_t i = INLINE_COLLIDER_SHAPES; i < hot.count; ++i)
             {
-                spriteSize = s.texture->GetNativeSize();
+                HotData<Collider>::SyncShape(c, i, c.overflow[i - INLINE_COLLIDER_SHAPES]);
             }
         }
 
         // Update each shape's bounding box
-        for (size_t i = 0; i < c.shapes.size(); ++i)
+        for (size_t i = 0; i < hot.count; ++i)
         {
-            const auto& shape = c.shapes[i];
-            if (!shape.isActive) continue;
+            if (!hot.IsActive(i)) continue;
+
+            ColliderShapeHot& shape = hot.GetShape(i, &c);
 
             // Determine actual size based on autoFitToSprite flag
             Vec2 effectiveSize;
-            if (shape.autoFitToSprite)
+            if (hot.AutoFits(i))
             {
                 effectiveSize = spriteSize;
             }
@@ -100,141 +129,184 @@ void Uma_ECS::CollisionSystem::UpdateBoundingBoxes()
 
             // Update runtime bounding box
             Vec2 halfSize = scaledSize * 0.5f;
-            c.bounds[i].min = worldPosition - halfSize;
-            c.bounds[i].max = worldPosition + halfSize;
+            shape.bounds.min = worldPosition - halfSize;
+            shape.bounds.max = worldPosition + halfSize;
         }
     }
 }
 
-void Uma_ECS::CollisionSystem::UpdateCollision(float dt)
+void Uma_ECS::CollisionSystem::UpdateCollision()
 {
-    if (aEntities.empty()) return;
+    mStats = BroadphaseStats{};
+
+    if (aEntities.empty())
+    {
+        mGrid.Clear();
+        mSweepAndPrune.Clear();
+        mAABBTree.Clear();
+        return;
+    }
 
     auto& tfArray = gCoordinator->GetComponentArray<Transform>();
     auto& cArray = gCoordinator->GetComponentArray<Collider>();
     auto& rbArray = gCoordinator->GetComponentArray<RigidBody>();
 
-    // Build spatial grid for broad phase
-    std::unordered_map<Cell, std::vector<Entity>, CellHash> grid;
+    // Update the broad phase, both keep their state across frames and share the same frame protocol
+    auto updateBroadphase = [&](auto& broadphase)
+        {
+            broadphase.BeginFrame();
 
-    for (const auto& entity : aEntities)
+            for (auto [entity, collider, tf, rb] : gCoordinator->View<Collider, Transform, RigidBody>())
+            {
+                const ColliderHot& hot = cArray.GetHot(collider);
+                if (hot.count == 0 || !hot.IsActive(0)) continue;
+
+                // union of the active shapes, environment only colliders are never moved by the resolution
+                BoundingBox bounds = hot.shapes[0].bounds;
+                bool isStatic = hot.shapes[0].purpose == ColliderPurpose::Environment;
+
+                for (size_t i = 1; i < hot.count; ++i)
+                {
+                    if (!hot.IsActive(i)) continue;
+
+                    const ColliderShapeHot& shape = hot.GetShape(i, &collider);
+                    bounds = UnionBox(bounds, shape.bounds);
+                    isStatic = isStatic && shape.purpose == ColliderPurpose::Environment;
+                }
+
+                broadphase.Update(entity, bounds, isStatic);
+
+                if (aBroadphaseBounds.size() <= entity) aBroadphaseBounds.resize(static_cast<size_t>(entity) + 1);
+                aBroadphaseBounds[entity] = bounds;
+            }
+
+            // destroyed / disabled colliders and the ones whose primary shape was turned off
+            broadphase.Sweep();
+
+            aPairs.clear();
+            mStats.testedPairs = broadphase.GatherPairs(aPairs);
+        };
+
+    if (mBroadphaseMode == BroadphaseMode::BM_SweepAndPrune)
     {
-        auto& collider = cArray.GetData(entity);
-        if (!collider.shapes.empty() && collider.shapes[0].isActive)
-        {
-            InsertIntoGrid(grid, entity, collider.bounds[0]);
-        }
+        updateBroadphase(mSweepAndPrune);
+    }
+    else if (mBroadphaseMode == BroadphaseMode::BM_AABBTree)
+    {
+        updateBroadphase(mAABBTree);
     }
+    else
+    {
+        updateBroadphase(mGrid);
+    }
+
+    // Every candidate pair once, in entity order
+    SortPairs(aPairs, aPairScratch);
+    mStats.candidatePairs = aPairs.size();
+
+    // Narrow phase: the shape pairs of every candidate pair tested in one batch, the bounds don't change
+    // until the next update so the resolution below can't change what overlaps
+    mShapeBatch.Clear();
+    aShapeRefs.clear();
+
+    // the grid's pairs only share a cell, most of them have no shape pair close enough to be worth batching
+    // (the other broadphases only hand out pairs whose bounds overlap)
+    const bool boundsChecked = mBroadphaseMode != BroadphaseMode::BM_Grid;
 
-    // Check collisions within each cell
-    for (auto const& [cell, entities] : grid)
+    for (size_t i = 0; i < aPairs.size(); ++i)
     {
-        for (size_t i = 0; i < entities.size(); ++i)
-        {
-            for (size_t j = i + 1; j < entities.size(); ++j)
-            {
-                Entity e1 = entities[i];
-                Entity e2 = entities[j];
+        Entity e1 = PairFirst(aPairs[i]);
+        Entity e2 = PairSecond(aPairs[i]);
 
-                CheckEntityPairCollision(e1, e2, tfArray, cArray, rbArray, dt);
-            }
-        }
+        if (!boundsChecked && !OverlapsBox(aBroadphaseBounds[e1], aBroadphaseBounds[e2])) continue;
+
+        BatchEntityPair(static_cast<uint32_t>(i), e1, e2, cArray, rbArray);
+    }
+
+    aShapeHits.clear();
+    mShapeBatch.Test(aShapeHits, mNarrowPhasePath);
+
+    // in pair then shape order, same as testing the pairs one by one
+    for (uint32_t hit : aShapeHits)
+    {
+        ResolveShapePair(hit, tfArray, cArray, rbArray);
     }
 }
 
-void Uma_ECS::CollisionSystem::CheckEntityPairCollision(
+void Uma_ECS::CollisionSystem::BatchEntityPair(
+    uint32_t pairIndex,
     Entity e1, Entity e2,
-    ComponentArray<Transform>& tfArray,
     ComponentArray<Collider>& cArray,
-    ComponentArray<RigidBody>& rbArray,
-    float dt)
+    ComponentArray<RigidBody>& rbArray)
 {
 
-    auto& c1 = cArray.GetData(e1);
-    auto& c2 = cArray.GetData(e2);
+    // hot halves only, layers and masks are already resolved
+    const ColliderHot& c1 = cArray.GetHot(e1);
+    const ColliderHot& c2 = cArray.GetHot(e2);
 
-    // Validate shapes exist
-    if (c1.shapes.empty() || c2.shapes.empty()) return;
-    if (!c1.shapes[0].isActive || !c2.shapes[0].isActive) return;
+    // the authoring halves are only looked up for the colliders with overflow shapes
+    const Collider* cold1 = c1.HasOverflow() ? &cArray.GetData(e1) : nullptr;
+    const Collider* cold2 = c2.HasOverflow() ? &cArray.GetData(e2) : nullptr;
 
-    // Check if entities have RigidBody (dynamic vs static)
-    bool e1HasRb = rbArray.Has(e1);
-    bool e2HasRb = rbArray.Has(e2);
+    // Validate shapes exist
+    if (c1.count == 0 || c2.count == 0) return;
+    if (!c1.IsActive(0) || !c2.IsActive(0)) return;
 
     // Skip if both static (optimization)
-    if (!e1HasRb && !e2HasRb)
+    if (!rbArray.Has(e1) && !rbArray.Has(e2))
         return;
 
-    // Broad phase: check primary bounds
-    /*if (!CollisionIntersection_RectRect_Static(c1.bounds[0], c2.bounds[0]))
-        return;*/
-
-    // Get components
-    auto& tf1 = tfArray.GetData(e1);
-    auto& tf2 = tfArray.GetData(e2);
-
-    RigidBody* rb1 = e1HasRb ? &rbArray.GetData(e1) : nullptr;
-    RigidBody* rb2 = e2HasRb ? &rbArray.GetData(e2) : nullptr;
-
-    // Narrow phase: check all shape pairs
-    for (size_t i = 0; i < c1.shapes.size(); ++i)
+    // every active shape pair, the layer / purpose filters and the bounds test are done by the batch
+    for (size_t i = 0; i < c1.count; ++i)
     {
-        const auto& shape1 = c1.shapes[i];
-        if (!shape1.isActive) continue;
+        if (!c1.IsActive(i)) continue;
 
-        for (size_t j = 0; j < c2.shapes.size(); ++j)
-        {
-            const auto& shape2 = c2.shapes[j];
-            if (!shape2.isActive) continue;
+        const ColliderShapeHot& s1 = c1.GetShape(i, cold1);
 
-            // Layer filtering
-            LayerMask layer1 = c1.GetEffectiveLayer(i);
-            LayerMask mask1 = c1.GetEffectiveMask(i);
-            LayerMask layer2 = c2.GetEffectiveLayer(j);
-            LayerMask mask2 = c2.GetEffectiveMask(j);
+        for (size_t j = 0; j < c2.count; ++j)
+        {
+            if (!c2.IsActive(j)) continue;
 
-            if (!((layer1 & mask2) && (mask1 & layer2)))
-                continue;
+            const ColliderShapeHot& s2 = c2.GetShape(j, cold2);
 
-            // Purpose filtering
-            if (!ShouldPurposesCollide(shape1.purpose, shape2.purpose))
-                continue;
+            mShapeBatch.Add(
+                s1.bounds, s1.layer, s1.mask, s1.purpose,
+                s2.bounds, s2.layer, s2.mask, s2.purpose);
 
-            // Collision test
-            if (CollisionIntersection_RectRect_Static(c1.bounds[i], c2.bounds[j]))
-            {
-                HandleShapeCollision(
-                    e1, e2,
-                    tf1, tf2,
-                    rb1, rb2,
-                    c1.bounds[i], c2.bounds[j],
-                    shape1.purpose, shape2.purpose
-                );
-            }
+            aShapeRefs.push_back(ShapePairRef{ pairIndex, static_cast<uint8_t>(i), static_cast<uint8_t>(j) });
         }
     }
 }
 
-bool Uma_ECS::CollisionSystem::ShouldPurposesCollide(
-    ColliderPurpose p1,
-    ColliderPurpose p2)
+void Uma_ECS::CollisionSystem::ResolveShapePair(
+    uint32_t hit,
+    ComponentArray<Transform>& tfArray,
+    ComponentArray<Collider>& cArray,
+    ComponentArray<RigidBody>& rbArray)
 {
-    // Triggers always detect but never block
-    if (p1 == ColliderPurpose::Trigger || p2 == ColliderPurpose::Trigger)
-        return true;
-
-    // Physics collides with Physics and Environment
-    if (p1 == ColliderPurpose::Physics)
-        return (p2 == ColliderPurpose::Physics || p2 == ColliderPurpose::Environment);
-
-    if (p2 == ColliderPurpose::Physics)
-        return (p1 == ColliderPurpose::Physics || p1 == ColliderPurpose::Environment);
-
-    // Environment doesn't collide with Environment
-    return false;
+    const ShapePairRef& ref = aShapeRefs[hit];
+    Entity e1 = PairFirst(aPairs[ref.pair]);
+    Entity e2 = PairSecond(aPairs[ref.pair]);
+
+    const ColliderShapeHot& s1 = cArray.GetHot(e1).GetShape(ref.shape1, ref.shape1 < INLINE_COLLIDER_SHAPES ? nullptr : &cArray.GetData(e1));
+    const ColliderShapeHot& s2 = cArray.GetHot(e2).GetShape(ref.shape2, ref.shape2 < INLINE_COLLIDER_SHAPES ? nullptr : &cArray.GetData(e2));
+
+    PushedSides pushed = HandleShapeCollision(
+        e1, e2,
+        tfArray.GetData(e1), tfArray.GetData(e2),
+        rbArray.TryGetData(e1), rbArray.TryGetData(e2),
+        s1.bounds, s2.bounds,
+        s1.purpose, s2.purpose
+    );
+
+    ++mStats.contacts;
+
+    // only a pushed transform changed, its bounds are refreshed next update
+    if (pushed.first) tfArray.MarkChanged(e1);
+    if (pushed.second) tfArray.MarkChanged(e2);
 }
 
-void Uma_ECS::CollisionSystem::HandleShapeCollision(
+Uma_ECS::CollisionSystem::PushedSides Uma_ECS::CollisionSystem::HandleShapeCollision(
     Entity e1, Entity e2,
     Transform& tf1, Transform& tf2,
     RigidBody* rb1, RigidBody* rb2,
@@ -246,7 +318,7 @@ void Uma_ECS::CollisionSystem::HandleShapeCollision(
     {
         // TODO: Emit trigger event when event system is available
         // Example: pEventSystem->Emit<TriggerEnterEvent>(e1, e2);
-        return;
+        return PushedSides{};
     }
 
     // Determine if entities can move
@@ -281,11 +353,13 @@ void Uma_ECS::CollisionSystem::HandleShapeCollision(
 
     if (shouldResolve)
     {
-        ResolveAABBCollision(tf1, tf2, box1, box2, e1CanMove, e2CanMove, rb1, rb2);
+        return ResolveAABBCollision(tf1, tf2, box1, box2, e1CanMove, e2CanMove, rb1, rb2);
     }
+
+    return PushedSides{};
 }
 
-void Uma_ECS::CollisionSystem::ResolveAABBCollision(
+Uma_ECS::CollisionSystem::PushedSides Uma_ECS::CollisionSystem::ResolveAABBCollision(
     Transform& tf1, Transform& tf2,
     const BoundingBox& box1, const BoundingBox& box2,
     bool e1CanMove, bool e2CanMove,
@@ -306,7 +380,7 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
 
     // Early exit if not overlapping
     if (overlap.x <= 0 || overlap.y <= 0)
-        return;
+        return PushedSides{};
 
     // ═══════════════════════════════════════════════════════════
     // UNITY-STYLE: Find contact normal and penetration depth
@@ -341,6 +415,8 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
     // RESOLVE COLLISION
     // ═══════════════════════════════════════════════════════════
 
+    PushedSides pushed{};
+
     if (e1CanMove && e2CanMove)
     {
         // ───────────────────────────────────────────────────────
@@ -350,6 +426,7 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
         // Push both apart
         tf1.position += normal * (penetration * 0.5f);
         tf2.position -= normal * (penetration * 0.5f);
+        pushed = PushedSides{ true, true };
 
         if (rb1 && rb2)
         {
@@ -373,6 +450,7 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
     {
         // Push out of wall
         tf1.position += normal * penetration;
+        pushed.first = true;
 
         float velAlongNormal = rb1->velocity.x * normal.x + rb1->velocity.y * normal.y;
 
@@ -395,6 +473,7 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
     {
         // Push out of wall
         tf2.position -= normal * penetration;
+        pushed.second = true;
 
         // ═══════════════════════════════════════════════════════════
         // TOP-DOWN FIX: Zero velocity AND acceleration on wall hit
@@ -426,6 +505,8 @@ void Uma_ECS::CollisionSystem::ResolveAABBCollision(
 
 
     }
+
+    return pushed;
 }
 
 Vec2 Uma_ECS::CollisionSystem::GetCollisionNormal(
@@ -450,32 +531,3 @@ Vec2 Uma_ECS::CollisionSystem::GetCollisionNormal(
 
     return delta;
 }
-
-void Uma_ECS::CollisionSystem::InsertIntoGrid(
-    std::unordered_map<Cell, std::vector<Entity>, CellHash>& grid,
-    Entity entity,
-    const BoundingBox& box)
-{
-    int minX = WorldToCell(box.min.x);
-    int maxX = WorldToCell(box.max.x);
-    int minY = WorldToCell(box.min.y);
-    int maxY = WorldToCell(box.max.y);
-
-    for (int x = minX; x <= maxX; ++x)
-    {
-        for (int y = minY; y <= maxY; ++y)
-        {
-            grid[Cell{ x, y }].push_back(entity);
-        }
-    }
-}
-
-bool Uma_ECS::CollisionSystem::CollisionIntersection_RectRect_Static(
-    const BoundingBox& lhs,
-    const BoundingBox& rhs)
-{
-    return !(lhs.max.x < rhs.min.x || // lhs is left of rhs
-        lhs.min.x > rhs.max.x || // lhs is right of rhs
-        lhs.max.y < rhs.min.y || // lhs is below rhs
-        lhs.min.y > rhs.max.y);  // lhs is above rhs
-}
\ No newline at end of file
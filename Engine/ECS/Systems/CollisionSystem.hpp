@@ -1,4 +1,4 @@
-/*!
+﻿/*!
 \file   CollisionSystem.hpp
 \par    Project: GAM200
 \par    Course: CSD2401
@@ -14,7 +14,10 @@ Defines collision detection and resolution system using spatial hashing with AAB
 
 Unity-inspired approach with contact normals, velocity projection, and purpose-based resolution.
 Provides layer-based collision filtering through bitmask operations on Collider components.
-Cell struct and CellHash functor enable grid-based spatial partitioning with configurable CELL_SIZE constant.
+The broadphase is kept across frames, a SpatialHashGrid (cell size can be changed at runtime), a SweepAndPrune or an
+AABBTreeBroadphase (dynamic tree + static tree for the walls) selected at runtime with SetBroadphaseMode. Each hands the
+narrow phase a sorted list of distinct candidate pairs, each pair is tested and resolved once per frame, a pair of two
+static colliders is never generated.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -25,36 +28,26 @@ All rights reserved.
 #include "../Core/System.hpp"
 #include "../Core/Coordinator.hpp"
 #include "Components/Collider.h"
+#include "SpatialHashGrid.hpp"
+#include "SweepAndPrune.hpp"
+#include "AABBTree.hpp"
+#include "ShapePairBatch.hpp"
 
 #include <unordered_set>
 
-const float CELL_SIZE = 100.0f; // Tune based on your game world
-
 namespace Uma_ECS
 {
-    struct Cell
-    {
-        int x, y;
-
-        bool operator==(const Cell& other) const
-        {
-            return x == other.x && y == other.y;
-        }
-    };
-
-    // Hash function for spatial grid
-    struct CellHash
-    {
-        std::size_t operator()(const Cell& c) const
-        {
-            return (std::hash<int>()(c.x) ^ (std::hash<int>()(c.y) << 1));
-        }
-    };
-
     struct Transform;
     struct Collider;
     struct RigidBody;
 
+    enum class BroadphaseMode
+    {
+        BM_Grid,          // uniform cells, cheap to update, best when colliders are spread out
+        BM_SweepAndPrune, // sorted intervals on X, best when most colliders barely move
+        BM_AABBTree       // dynamic + static trees, best when collider sizes vary a lot
+    };
+
     class CollisionSystem : public ECSSystem
     {
     public:
@@ -62,25 +55,58 @@ namespace Uma_ECS
 
         void Update(float dt);
 
+        // Tune based on your game world, every collider is re-inserted at the next update
+        inline void SetCellSize(float cellSize) { mGrid.SetCellSize(cellSize); }
+        inline float GetCellSize() const { return mGrid.GetCellSize(); }
+
+        // the broadphase left is emptied, switching back rebuilds it at the next update
+        void SetBroadphaseMode(BroadphaseMode mode);
+        inline BroadphaseMode GetBroadphaseMode() const { return mBroadphaseMode; }
+
+        inline const SpatialHashGrid& GetGrid() const { return mGrid; }
+        inline const SweepAndPrune& GetSweepAndPrune() const { return mSweepAndPrune; }
+        inline const AABBTreeBroadphase& GetAABBTree() const { return mAABBTree; }
+
+        // margin of the dynamic tree's fat boxes in BM_AABBTree
+        inline void SetFatMargin(float fatMargin) { mAABBTree.SetFatMargin(fatMargin); }
+
+        // pair counts of the last update
+        inline const BroadphaseStats& GetBroadphaseStats() const { return mStats; }
+
+        // instruction set of the narrow phase test, NATIVE_SIMD_PATH by default, every path gives the same result
+        inline void SetNarrowPhasePath(SimdPath path) { mNarrowPhasePath = path; }
+        inline SimdPath GetNarrowPhasePath() const { return mNarrowPhasePath; }
+
     private:
         // Bounding box update
         void UpdateBoundingBoxes();
 
         // Collision detection and resolution
-        void UpdateCollision(float dt);
+        void UpdateCollision();
 
-        void CheckEntityPairCollision(
+        // appends the active shape pairs of a candidate pair to the narrow phase batch
+        void BatchEntityPair(
+            uint32_t pairIndex,
             Entity e1, Entity e2,
+            ComponentArray<Collider>& cArray,
+            ComponentArray<RigidBody>& rbArray);
+
+        // resolves one shape pair that passed the batch test
+        void ResolveShapePair(
+            uint32_t hit,
             ComponentArray<Transform>& tfArray,
             ComponentArray<Collider>& cArray,
-            ComponentArray<RigidBody>& rbArray,
-            float dt);
+            ComponentArray<RigidBody>& rbArray);
 
-        // Purpose-based collision filtering
-        bool ShouldPurposesCollide(ColliderPurpose p1, ColliderPurpose p2);
+        // which transforms a resolution pushed, the others (triggers, walls, static sides) are left untouched
+        struct PushedSides
+        {
+            bool first = false;
+            bool second = false;
+        };
 
         // Unity-style collision handling
-        void HandleShapeCollision(
+        PushedSides HandleShapeCollision(
             Entity e1, Entity e2,
             Transform& tf1, Transform& tf2,
             RigidBody* rb1, RigidBody* rb2,
@@ -88,7 +114,7 @@ namespace Uma_ECS
             ColliderPurpose purpose1, ColliderPurpose purpose2);
 
         // Unity-style AABB resolution with contact normals
-        void ResolveAABBCollision(
+        PushedSides ResolveAABBCollision(
             Transform& tf1, Transform& tf2,
             const BoundingBox& box1, const BoundingBox& box2,
             bool e1CanMove, bool e2CanMove,
@@ -97,22 +123,38 @@ namespace Uma_ECS
         // Helper functions
         Vec2 GetCollisionNormal(const BoundingBox& box1, const BoundingBox& box2);
 
-        inline int WorldToCell(float coord)
-        {
-            return static_cast<int>(std::floor(coord / CELL_SIZE));
-        }
+        Coordinator* gCoordinator = nullptr;
 
-        void InsertIntoGrid(
-            std::unordered_map<Cell, std::vector<Entity>, CellHash>& grid,
-            Entity e,
-            const BoundingBox& box);
+        // change tick of the previous bounds update, see UpdateBoundingBoxes
+        ChangeTick mLastBoundsTick = 0;
 
-        // AABB intersection test
-        bool CollisionIntersection_RectRect_Static(
-            const BoundingBox& lhs,
-            const BoundingBox& rhs);
+        // broadphase, kept across frames
+        BroadphaseMode mBroadphaseMode = BroadphaseMode::BM_Grid;
+        SpatialHashGrid mGrid;
+        SweepAndPrune mSweepAndPrune;
+        AABBTreeBroadphase mAABBTree;
 
-        Coordinator* gCoordinator = nullptr;
+        // candidate pairs of the current update, reused across frames
+        std::vector<PairKey> aPairs;
+
+        // union of the active shapes handed to the broadphase this update, indexed by entity id
+        std::vector<BoundingBox> aBroadphaseBounds;
+
+        // narrow phase, the shape pairs of the candidate pairs tested in one batch, reused across frames
+        struct ShapePairRef
+        {
+            uint32_t pair;  // index in aPairs
+            uint8_t shape1; // shape of the pair's first entity
+            uint8_t shape2;
+        };
+
+        ShapePairBatch mShapeBatch;
+        std::vector<ShapePairRef> aShapeRefs; // one per batch entry
+        std::vector<uint32_t> aShapeHits;
+        SimdPath mNarrowPhasePath = NATIVE_SIMD_PATH;
+        std::vector<PairKey> aPairScratch;
+
+        BroadphaseStats mStats;
 
         //// Track which entity pairs we've already resolved this frame
         //struct PairHash
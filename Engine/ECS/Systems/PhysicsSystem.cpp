@@ -13,7 +13,8 @@
 Implements Verlet-based physics integration with semi-implicit Euler method for velocity updates.
 
 Applies acceleration to velocity, exponential friction damping, and epsilon-based velocity clamping to prevent jitter.
-Stores previous position in Transform before updating for collision system's swept tests.
+The previous position comes from the Transform pool's previous buffer (published at the end of the last frame), only
+the transforms that actually moved or rotated since then are marked changed for the Changed<Transform> queries.
 Includes debug logging method (PrintLog) that outputs entity signatures and component data for Transform and RigidBody
 to console with formatted output showing total entity counts and system membership.
 
@@ -32,16 +33,10 @@ All rights reserved.
 
 void Uma_ECS::PhysicsSystem::Update(float dt)
 {
-    auto& rbArray = gCoordinator->GetComponentArray<RigidBody>();
     auto& tfArray = gCoordinator->GetComponentArray<Transform>();
 
-    for (auto const& entity : aEntities)
+    for (auto [entity, tf, rb] : gCoordinator->View<Transform, RigidBody>())
     {
-        auto& rb = rbArray.GetData(entity);
-        auto& tf = tfArray.GetData(entity);
-
-        tf.prevPos = tf.position;
-
         tf.rotation.x += tf.rotation.y; // I added this wai men
 
         // Apply acceleration
@@ -56,6 +51,12 @@ void Uma_ECS::PhysicsSystem::Update(float dt)
 
         tf.position += rb.velocity * dt;
 
+        // resting bodies are not stamped, systems filtering on Changed<Transform> skip them
+        if (!(tf.position == tfArray.GetPrevious(tf).position) || tf.rotation.y != 0.f)
+        {
+            tfArray.MarkChanged(entity);
+        }
+
         //rb.acceleration = { 0, 0 };
     }
 
@@ -118,7 +119,7 @@ void Uma_ECS::PhysicsSystem::PrintLog()
         if (sig.test(gCoordinator->GetComponentType<Transform>()))
         {
             hasAny = true;
-            auto& tf = gCoordinator->GetComponent<Transform>(entity);
+            const auto& tf = gCoordinator->ReadComponent<Transform>(entity);
             std::cout << "  Transform { "
                 << "position: (" << tf.position.x << ", " << tf.position.y << "), "
                 << "rotation: (" << tf.rotation.x << ", " << tf.rotation.y << "), "
@@ -129,7 +130,7 @@ void Uma_ECS::PhysicsSystem::PrintLog()
         if (sig.test(gCoordinator->GetComponentType<RigidBody>()))
         {
             hasAny = true;
-            auto& rb = gCoordinator->GetComponent<RigidBody>(entity);
+            const auto& rb = gCoordinator->ReadComponent<RigidBody>(entity);
             std::cout << "  RigidBody { "
                 << "velocity: (" << rb.velocity.x << ", " << rb.velocity.y << "), "
                 << "acceleration: (" << rb.acceleration.x << ", " << rb.acceleration.y << ") }\n";
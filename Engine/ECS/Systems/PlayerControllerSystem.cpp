@@ -45,6 +45,9 @@ namespace Uma_ECS
     {
         if (aEntities.empty()) return;
 
+        // a disabled player keeps its components but takes no input
+        if (!pCoordinator->IsEnabled(aEntities[0])) return;
+
         // by right shd only have 1 player
         HandleMovementInput(dt);
         HandleActionInput();
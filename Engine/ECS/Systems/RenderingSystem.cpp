@@ -12,11 +12,10 @@
 \brief
 Implements sprite batching and rendering system that groups sprites by texture ID for instanced drawing.
 
-Loads textures on-demand through ResourcesManager if not cached in SpriteRenderer component.
-Queries camera transform and zoom from Camera component to configure graphics viewport.
-Validates texture handles before rendering and logs warnings for invalid textures. Builds sorted map of sprites
-grouped by texture ID, then submits batched draw calls through Graphics API for optimal performance.
-Supports single camera setup with entity at index 0.
+Walks the Sprite pool's render layer index so sprites come out in layer order without a per-frame sort, then batches
+each layer by texture ID (shared sprite groups first) and submits the batches through the Graphics API. Reads the
+packed SpriteHot / ColliderHot records and the Transforms published by Coordinator::SwapBuffers, the authoring Sprite
+is only read to resolve a texture through ResourcesManager. Supports single camera setup with the first camera found.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -45,42 +44,68 @@ namespace Uma_ECS
         pCoordinator = c;
         pGraphics = g;
         pResourcesManager = rm;
+
+        pLayerIndex = &pCoordinator->CreateIndex<Sprite>([](const Sprite& sprite) { return sprite.renderLayer; });
     }
 
     void RenderingSystem::Update(float dt)
     {
         (void)dt;
 
-        if (!aEntities.size()) return;
+        // one camera for now
+        auto cameras = pCoordinator->View<Camera, Transform>();
+        auto cam_it = cameras.begin();
+        if (cam_it == cameras.end()) return;
+
+        auto [camera, cam_c, cam_tf] = *cam_it;
 
-        auto& srArray = pCoordinator->GetComponentArray<Sprite>();
+        // everything drawn comes from the published transforms
         auto& tfArray = pCoordinator->GetComponentArray<Transform>();
-        auto& camArray = pCoordinator->GetComponentArray<Camera>();
+
+        pGraphics->SetCamInfo(tfArray.GetPrevious(cam_tf).position, 10);
+
+        auto& sArray = pCoordinator->GetComponentArray<Sprite>();
         auto& cArray = pCoordinator->GetComponentArray<Collider>();
-        auto& pArray = pCoordinator->GetComponentArray<Player>();
 
-        // one camera for now
-        Entity camera = camArray.GetEntity(0);
-        auto& cam_tf = tfArray.GetData(camera);
-        auto& cam_c = camArray.GetData(camera);
+        // the hot records of the sprites / colliders edited since the last frame pick up the authoring data
+        sArray.SyncHot();
+        cArray.SyncHot();
+
+        // static sprites shared by many entities (walls, floors), drawn with the batches of their layer
+        SortSharedGroups();
+
+        // the layer index already is in layer order, no sort, the batches below keep that order
+        aDrawList.clear();
+        pLayerIndex->ForEach([&](LayerMask layer, const std::vector<Entity>& entities)
+            {
+                for (Entity entity : entities)
+                {
+                    if (!pCoordinator->IsEnabled(entity)) continue;
 
-        pGraphics->SetCamInfo(cam_tf.position, 10);
+                    const Transform* tf = tfArray.TryGetPrevious(entity);
+                    if (!tf) continue;
 
-        // need to sort the entities before rendering based on their layer
-        SortEntitiesByLayer(aEntities);
+                    aDrawList.push_back(DrawEntry{ entity, layer, &sArray.GetHot(entity), tf });
+                }
+            });
 
-        // Iterate over the smaller array for efficiency (here, RigidBody)
-        std::unordered_map<unsigned int, std::vector<Uma_Engine::Sprite_Info>> sorted_sprites;
+        // one batch per (layer, texture), a layer's batches start at layerStart
+        mBatchCount = 0;
+        size_t layerStart = 0;
 
-        for (const auto& entity : aEntities)
+        for (const auto& draw : aDrawList)
         {
-            auto& sr = srArray.GetData(entity);
-            auto& tf = tfArray.GetData(entity);
+            Entity entity = draw.entity;
+            auto& sr = *draw.pSprite;
+            auto& tf = *draw.pTransform;
 
-            // Load texture if not already loaded
+            // Load texture if not already loaded, the name is only in the authoring half
             if (!sr.texture)
             {
-                sr.texture = pResourcesManager->GetTexture(sr.textureName);
+                sr.texture = pResourcesManager->GetTexture(sArray.GetData(entity).textureName);
+
+                // colliders fitted to the sprite size depend on the texture
+                pCoordinator->MarkChanged<Sprite>(entity);
             }
 
             // Verify texture is valid before using it
@@ -107,7 +132,26 @@ namespace Uma_ECS
                 spriteScale = tf.scale;
             }
 
-            sorted_sprites[sr.texture->tex_id].push_back(Uma_Engine::Sprite_Info
+            if (mBatchCount == 0 || aBatches[mBatchCount - 1].layer != draw.layer)
+            {
+                layerStart = mBatchCount;
+            }
+
+            // a layer only uses a few textures, a linear search over its batches is enough
+            size_t batch = layerStart;
+            while (batch < mBatchCount && aBatches[batch].texId != sr.texture->tex_id) ++batch;
+
+            if (batch == mBatchCount)
+            {
+                if (mBatchCount == aBatches.size()) aBatches.emplace_back();
+
+                aBatches[batch].layer = draw.layer;
+                aBatches[batch].texId = sr.texture->tex_id;
+                aBatches[batch].aSprites.clear();
+                ++mBatchCount;
+            }
+
+            aBatches[batch].aSprites.push_back(Uma_Engine::Sprite_Info
                 {
                     .tex_id = sr.texture->tex_id,
                     //.tex_size = sr.texture->tex_size,
@@ -118,26 +162,35 @@ namespace Uma_ECS
                 });
         }
 
-        for (const auto& pair : sorted_sprites)
+        // both lists are in layer order, merged so a layer's shared groups go before its batches
+        auto& shared = pCoordinator->GetSharedComponentArray<Sprite>();
+        size_t nextGroup = 0;
+
+        for (size_t i = 0; i < mBatchCount; ++i)
         {
-            const std::vector<Uma_Engine::Sprite_Info>& sprites = pair.second;
+            while (nextGroup < aGroupOrder.size() && shared.GetGroupHot(aGroupOrder[nextGroup]).renderLayer <= aBatches[i].layer)
+            {
+                DrawSharedGroup(aGroupOrder[nextGroup++]);
+            }
 
             pGraphics->DrawSpritesInstanced(
-                pair.first,
-                sprites
+                aBatches[i].texId,
+                aBatches[i].aSprites
             );
         }
 
+        for (; nextGroup < aGroupOrder.size(); ++nextGroup)
+        {
+            DrawSharedGroup(aGroupOrder[nextGroup]);
+        }
+
         
         // this is for debug drawing 
         // NEED TO CLEAN THIS CODE OMG
         // REMINE ME NEXT TIME I WILL FORGET
-        for (const auto& entity : aEntities)
+        for (auto [entity, collider, tf] : pCoordinator->View<Collider, Transform>())
         {
-            if (!cArray.Has(entity)) continue;
-
-            auto& c = cArray.GetData(entity);
-            auto& tf = tfArray.GetData(entity);
+            const ColliderHot& c = cArray.GetHot(collider);
 
             // Debug draw
             if (!c.showBBox)
@@ -145,30 +198,32 @@ namespace Uma_ECS
                 continue;
             }
 
-            for (size_t i = 0; i < c.shapes.size(); i++)
+            // overflow shapes edited since the last collision update have no bounds yet
+            size_t count = std::min(static_cast<size_t>(c.count), INLINE_COLLIDER_SHAPES + collider.overflow.size());
+
+            for (size_t i = 0; i < count; i++)
             {
-                if (!c.shapes[i].isActive) continue;
-                if (i >= c.bounds.size()) continue;
+                if (!c.IsActive(i)) continue;
 
-                const auto& shape = c.shapes[i];
-                const auto& bounds = c.bounds[i];
+                const ColliderShapeHot& shape = c.GetShape(i, &collider);
+                const auto& bounds = shape.bounds;
+                const ColliderPurpose purpose = shape.purpose;
 
-                LayerMask effectiveLayer = c.GetEffectiveLayer(i);
-                LayerMask effectiveMask = c.GetEffectiveMask(i);
+                LayerMask effectiveMask = shape.mask;
 
                 float r = 1.f, g = 0.f, b = 0.f;
 
-                if (shape.purpose == ColliderPurpose::Trigger)
+                if (purpose == ColliderPurpose::Trigger)
                 {
                     // Triggers: Blue
                     r = 0.f; g = 0.f; b = 1.f;
                 }
-                else if (shape.purpose == ColliderPurpose::Environment)
+                else if (purpose == ColliderPurpose::Environment)
                 {
                     // Walls: Green
                     r = 0.f; g = 1.f; b = 0.f;
                 }
-                else if (shape.purpose == ColliderPurpose::Physics)
+                else if (purpose == ColliderPurpose::Physics)
                 {
                     // Check what it collides with
                     if (effectiveMask & CL_WALL)
@@ -193,19 +248,78 @@ namespace Uma_ECS
         }
     }
 
-    void RenderingSystem::SortEntitiesByLayer(std::vector<Entity>& sorted)
+    void RenderingSystem::SortSharedGroups()
     {
-        // sort it
-
-        auto& srArray = pCoordinator->GetComponentArray<Sprite>();
+        auto& shared = pCoordinator->GetSharedComponentArray<Sprite>();
 
-        std::sort(sorted.begin(), sorted.end(),
-            [&srArray](Entity const& a, Entity const& b)
+        // the groups are already the batches, only their order is needed
+        aGroupOrder.clear();
+        shared.ForEachGroup([this](Entity group, const Sprite&, SpriteHot&, const std::vector<Entity>&)
             {
-                auto& spriteA = srArray.GetData(a);
-                auto& spriteB = srArray.GetData(b);
+                aGroupOrder.push_back(group);
+            });
 
-                return spriteA.renderLayer < spriteB.renderLayer;
+        std::stable_sort(aGroupOrder.begin(), aGroupOrder.end(),
+            [&shared](Entity a, Entity b)
+            {
+                return shared.GetGroupHot(a).renderLayer < shared.GetGroupHot(b).renderLayer;
             });
     }
+
+    void RenderingSystem::DrawSharedGroup(Entity group)
+    {
+        auto& shared = pCoordinator->GetSharedComponentArray<Sprite>();
+        auto& tfArray = pCoordinator->GetComponentArray<Transform>();
+
+        SpriteHot& sr = shared.GetGroupHot(group);
+
+        // once for the whole group
+        if (!sr.texture)
+        {
+            sr.texture = pResourcesManager->GetTexture(shared.GetGroupValue(group).textureName);
+
+            // colliders fitted to the sprite size depend on the texture
+            shared.MarkGroupChanged(group);
+        }
+
+        if (!sr.texture || sr.texture->tex_id == 0)
+        {
+            std::stringstream log;
+            log << "Shared sprite(" << shared.GetGroupValue(group).textureName << ") texture is not valid.";
+            Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eWarning, log.str());
+            return;
+        }
+
+        Vec2 nativeSize = sr.texture->GetNativeSize();
+
+        aBatch.clear();
+        for (Entity entity : shared.GetGroupEntities(group))
+        {
+            if (!pCoordinator->IsEnabled(entity)) continue;
+
+            const Transform* tf = tfArray.TryGetPrevious(entity);
+            if (!tf) continue;
+
+            Vec2 spriteScale = tf->scale;
+            if (sr.UseNativeSize)
+            {
+                spriteScale.x *= nativeSize.x;
+                spriteScale.y *= nativeSize.y;
+            }
+
+            aBatch.push_back(Uma_Engine::Sprite_Info
+                {
+                    .tex_id = sr.texture->tex_id,
+                    .pos = tf->position,
+                    .scale = spriteScale,
+                    .rot = tf->rotation.x,
+                    .rot_speed = tf->rotation.y,
+                });
+        }
+
+        if (!aBatch.empty())
+        {
+            pGraphics->DrawSpritesInstanced(sr.texture->tex_id, aBatch);
+        }
+    }
 }
\ No newline at end of file
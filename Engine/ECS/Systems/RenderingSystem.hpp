@@ -13,7 +13,10 @@
 Defines rendering system that orchestrates sprite drawing through graphics API with texture batching optimization.
 
 Operates on entities with SpriteRenderer and Transform components to extract sprite data and world positions.
+Init creates a render layer index over the Sprite pool, so the Sprite component must be registered before.
 Requires initialization with Graphics renderer, ResourcesManager for texture loading, and Coordinator for component queries.
+Entities with a shared sprite (Shared<Sprite>, registered with RegisterSharedComponent<Sprite>) and a Transform are drawn
+one instanced batch per sprite group, the texture is resolved once per group, in render layer order with the other sprites.
 
 All content (C) 2025 DigiPen Institute of Technology Singapore.
 All rights reserved.
@@ -30,6 +33,10 @@ All rights reserved.
 
 namespace Uma_ECS
 {
+    struct Sprite;
+    struct SpriteHot;
+    struct Transform;
+
     class RenderingSystem : public ECSSystem
     {
     public:
@@ -37,9 +44,43 @@ namespace Uma_ECS
 
         void Update(float dt);
 
-        void SortEntitiesByLayer(std::vector<Entity>& sorted);
-
     private:
+        struct DrawEntry
+        {
+            Entity entity;
+            LayerMask layer;
+            SpriteHot* pSprite;
+            const Transform* pTransform;
+        };
+
+        // shared sprite groups into aGroupOrder, in layer order
+        void SortSharedGroups();
+
+        // one batch for a shared sprite group, the texture is resolved once per group
+        void DrawSharedGroup(Entity group);
+
+        // rebuilt every frame in layer order, kept as a member so the memory is reused
+        std::vector<DrawEntry> aDrawList;
+
+        // sprites of one texture on one layer, submitted as one instanced draw
+        struct SpriteBatch
+        {
+            LayerMask layer = 0;
+            unsigned int texId = 0;
+            std::vector<Uma_Engine::Sprite_Info> aSprites;
+        };
+
+        // the batches of the frame in layer order, only the first mBatchCount are used, the others keep their memory
+        std::vector<SpriteBatch> aBatches;
+        size_t mBatchCount = 0;
+
+        // sprites by render layer, walked in order instead of sorting the draw list every frame
+        ComponentIndex<Sprite, LayerMask>* pLayerIndex = nullptr;
+
+        // shared sprite groups in layer order and the batch being built, reused every frame
+        std::vector<Entity> aGroupOrder;
+        std::vector<Uma_Engine::Sprite_Info> aBatch;
+
 
         Coordinator* pCoordinator = nullptr;
         Uma_Engine::Graphics* pGraphics = nullptr;
@@ -0,0 +1,284 @@
+/*!
+\file   ShapePairBatch.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements ShapePairBatch, the batched narrow phase test of CollisionSystem.
+
+Shape pairs are gathered in blocks of 8, one array per bound coordinate, layer, mask and purpose of each side, then
+tested 8 at a time with AVX2, 4 at a time with SSE2 or one at a time on the scalar path (ECS_NO_SIMD, non x64).
+The bounds overlap and the layer / purpose filters share the same lane masks, unused lanes never pass and every
+path hands back the same pairs in order, touching boxes included.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "../Core/Types.hpp"
+#include "../Components/Collider.h"
+
+#include <vector>
+#include <cstdint>
+#include <bit>
+
+// define ECS_NO_SIMD to compile the narrow phase to its scalar path only
+#if !defined(ECS_NO_SIMD)
+#if defined(__AVX2__)
+#define ECS_SIMD_AVX2
+#define ECS_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ECS_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace Uma_ECS
+{
+    enum class SimdPath
+    {
+        SP_Scalar,
+        SP_SSE2,  // 4 shape pairs per test
+        SP_AVX2   // 8 shape pairs per test
+    };
+
+    // widest path compiled in
+#if defined(ECS_SIMD_AVX2)
+    constexpr SimdPath NATIVE_SIMD_PATH = SimdPath::SP_AVX2;
+#elif defined(ECS_SIMD_SSE2)
+    constexpr SimdPath NATIVE_SIMD_PATH = SimdPath::SP_SSE2;
+#else
+    constexpr SimdPath NATIVE_SIMD_PATH = SimdPath::SP_Scalar;
+#endif
+
+    // purpose as one bit
+    constexpr uint32_t PurposeBit(ColliderPurpose purpose)
+    {
+        return 1u << static_cast<uint32_t>(purpose);
+    }
+
+    // bits of the purposes each purpose collides with, indexed by ColliderPurpose
+    // triggers detect everything, physics collides with physics and environment, environment never with environment
+    constexpr uint32_t PURPOSE_COLLIDES_WITH[] =
+    {
+        // Physics
+        PurposeBit(ColliderPurpose::Physics) | PurposeBit(ColliderPurpose::Environment) | PurposeBit(ColliderPurpose::Trigger),
+        // Environment
+        PurposeBit(ColliderPurpose::Physics) | PurposeBit(ColliderPurpose::Trigger),
+        // Trigger
+        PurposeBit(ColliderPurpose::Physics) | PurposeBit(ColliderPurpose::Environment) | PurposeBit(ColliderPurpose::Trigger)
+    };
+
+    constexpr uint32_t PurposeCollidesWith(ColliderPurpose purpose)
+    {
+        return PURPOSE_COLLIDES_WITH[static_cast<size_t>(purpose)];
+    }
+
+    class ShapePairBatch
+    {
+    public:
+        // true if the path is compiled in, Test falls back to the scalar path otherwise
+        static constexpr bool IsAvailable(SimdPath path)
+        {
+            switch (path)
+            {
+#if defined(ECS_SIMD_AVX2)
+            case SimdPath::SP_AVX2: return true;
+#endif
+#if defined(ECS_SIMD_SSE2)
+            case SimdPath::SP_SSE2: return true;
+#endif
+            case SimdPath::SP_Scalar: return true;
+            default: return false;
+            }
+        }
+
+        // empties the batch, the memory is kept
+        void Clear()
+        {
+            aBlocks.clear();
+            mSize = 0;
+        }
+
+        // appends the shape pair (a, b), its index is the size of the batch before the call
+        void Add(const BoundingBox& boxA, LayerMask layerA, LayerMask maskA, ColliderPurpose purposeA,
+            const BoundingBox& boxB, LayerMask layerB, LayerMask maskB, ColliderPurpose purposeB)
+        {
+            const size_t lane = mSize % LANES;
+
+            // a new block starts zeroed, its unused lanes have no layer and never pass
+            if (lane == 0) aBlocks.emplace_back();
+
+            Block& block = aBlocks.back();
+            block.minXA[lane] = boxA.min.x; block.minYA[lane] = boxA.min.y;
+            block.maxXA[lane] = boxA.max.x; block.maxYA[lane] = boxA.max.y;
+            block.minXB[lane] = boxB.min.x; block.minYB[lane] = boxB.min.y;
+            block.maxXB[lane] = boxB.max.x; block.maxYB[lane] = boxB.max.y;
+
+            block.layerA[lane] = layerA;
+            block.maskA[lane] = maskA;
+            block.purposeA[lane] = PurposeBit(purposeA);
+
+            block.layerB[lane] = layerB;
+            block.maskB[lane] = maskB;
+            block.purposeB[lane] = PurposeCollidesWith(purposeB);
+
+            ++mSize;
+        }
+
+        inline size_t Size() const { return mSize; }
+
+        // appends the index of every shape pair whose layers, masks and purposes let them collide and whose bounds
+        // overlap, in ascending order
+        void Test(std::vector<uint32_t>& hits, [[maybe_unused]] SimdPath path = NATIVE_SIMD_PATH) const
+        {
+#if defined(ECS_SIMD_AVX2)
+            if (path == SimdPath::SP_AVX2)
+            {
+                TestAVX2(hits);
+                return;
+            }
+#endif
+#if defined(ECS_SIMD_SSE2)
+            if (path == SimdPath::SP_SSE2)
+            {
+                TestSSE2(hits);
+                return;
+            }
+#endif
+
+            TestScalar(hits);
+        }
+
+    private:
+        static constexpr size_t LANES = 8;
+
+        // LANES shape pairs, one array per field so a whole block is tested with a few loads
+        struct alignas(32) Block
+        {
+            // side a
+            float minXA[LANES], minYA[LANES], maxXA[LANES], maxYA[LANES];
+            uint32_t layerA[LANES], maskA[LANES];
+            uint32_t purposeA[LANES]; // PurposeBit
+
+            // side b
+            float minXB[LANES], minYB[LANES], maxXB[LANES], maxYB[LANES];
+            uint32_t layerB[LANES], maskB[LANES];
+            uint32_t purposeB[LANES]; // PurposeCollidesWith
+        };
+
+        // the reference every path must agree with
+        void TestScalar(std::vector<uint32_t>& hits) const
+        {
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                const Block& b = aBlocks[i / LANES];
+                const size_t l = i % LANES;
+
+                if ((b.layerA[l] & b.maskB[l]) == 0 || (b.maskA[l] & b.layerB[l]) == 0) continue;
+                if ((b.purposeA[l] & b.purposeB[l]) == 0) continue;
+                if (b.maxXA[l] < b.minXB[l] || b.minXA[l] > b.maxXB[l] || b.maxYA[l] < b.minYB[l] || b.minYA[l] > b.maxYB[l]) continue;
+
+                hits.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        // appends the set lanes of bits as indices from base
+        static inline void AppendLanes(std::vector<uint32_t>& hits, size_t base, unsigned bits)
+        {
+            while (bits)
+            {
+                hits.push_back(static_cast<uint32_t>(base + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+
+#if defined(ECS_SIMD_SSE2)
+        // each block in two halves of 4 lanes
+        void TestSSE2(std::vector<uint32_t>& hits) const
+        {
+            const __m128i zero = _mm_setzero_si128();
+
+            for (size_t blockIndex = 0; blockIndex < aBlocks.size(); ++blockIndex)
+            {
+                const Block& b = aBlocks[blockIndex];
+
+                for (size_t half = 0; half < LANES; half += 4)
+                {
+                    // all ones in the lanes rejected by the filters
+                    auto none = [&](const uint32_t* x, const uint32_t* y)
+                        {
+                            __m128i both = _mm_and_si128(
+                                _mm_load_si128(reinterpret_cast<const __m128i*>(x + half)),
+                                _mm_load_si128(reinterpret_cast<const __m128i*>(y + half)));
+                            return _mm_cmpeq_epi32(both, zero);
+                        };
+
+                    __m128i filtered = _mm_or_si128(_mm_or_si128(none(b.layerA, b.maskB), none(b.maskA, b.layerB)), none(b.purposeA, b.purposeB));
+
+                    // all ones in the lanes where the boxes are apart on either axis, false on NaN like the scalar <
+                    auto apart = [&](const float* lhs, const float* rhs)
+                        {
+                            return _mm_cmplt_ps(_mm_load_ps(lhs + half), _mm_load_ps(rhs + half));
+                        };
+
+                    __m128 separated = _mm_or_ps(_mm_or_ps(apart(b.maxXA, b.minXB), apart(b.maxXB, b.minXA)),
+                        _mm_or_ps(apart(b.maxYA, b.minYB), apart(b.maxYB, b.minYA)));
+
+                    __m128 rejected = _mm_or_ps(separated, _mm_castsi128_ps(filtered));
+
+                    AppendLanes(hits, blockIndex * LANES + half, static_cast<unsigned>(~_mm_movemask_ps(rejected)) & 0xFu);
+                }
+            }
+        }
+#endif
+
+#if defined(ECS_SIMD_AVX2)
+        // one block per test
+        void TestAVX2(std::vector<uint32_t>& hits) const
+        {
+            const __m256i zero = _mm256_setzero_si256();
+
+            for (size_t blockIndex = 0; blockIndex < aBlocks.size(); ++blockIndex)
+            {
+                const Block& b = aBlocks[blockIndex];
+
+                auto none = [&](const uint32_t* x, const uint32_t* y)
+                    {
+                        __m256i both = _mm256_and_si256(
+                            _mm256_load_si256(reinterpret_cast<const __m256i*>(x)),
+                            _mm256_load_si256(reinterpret_cast<const __m256i*>(y)));
+                        return _mm256_cmpeq_epi32(both, zero);
+                    };
+
+                __m256i filtered = _mm256_or_si256(_mm256_or_si256(none(b.layerA, b.maskB), none(b.maskA, b.layerB)), none(b.purposeA, b.purposeB));
+
+                // ordered compares, false on NaN like the scalar <
+                auto apart = [&](const float* lhs, const float* rhs)
+                    {
+                        return _mm256_cmp_ps(_mm256_load_ps(lhs), _mm256_load_ps(rhs), _CMP_LT_OQ);
+                    };
+
+                __m256 separated = _mm256_or_ps(_mm256_or_ps(apart(b.maxXA, b.minXB), apart(b.maxXB, b.minXA)),
+                    _mm256_or_ps(apart(b.maxYA, b.minYB), apart(b.maxYB, b.minYA)));
+
+                __m256 rejected = _mm256_or_ps(separated, _mm256_castsi256_ps(filtered));
+
+                AppendLanes(hits, blockIndex * LANES, static_cast<unsigned>(~_mm256_movemask_ps(rejected)) & 0xFFu);
+            }
+        }
+#endif
+
+        std::vector<Block> aBlocks;
+        size_t mSize = 0;
+    };
+}
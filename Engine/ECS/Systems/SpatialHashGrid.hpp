@@ -0,0 +1,352 @@
+/*!
+\file   SpatialHashGrid.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements SpatialHashGrid, the persistent broadphase grid of CollisionSystem.
+
+The grid lives across frames. Every entity remembers the range of cells its bounds covered when it was inserted and
+is only moved when that range changes, an entity moving inside its cells costs four floors and a compare.
+Cells are found through a flat open-addressed table (linear probing, power of two capacity, multiplicative hash of
+both coordinates) pointing into a packed list of cells, each with its own entity list. Emptied cells keep their list
+so a body walking back and forth allocates nothing, they are only dropped when the table grows.
+Entities not updated during a frame (destroyed, disabled, lost their collider) are dropped by Sweep.
+GatherPairs lists every pair of entities sharing a cell once, except pairs of two static entities: a pair is only taken from its owner cell, the cell at
+the top left corner of the overlap of both cell ranges, so bodies spanning several cells are not paired once per cell.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "../Core/Types.hpp"
+#include "../Components/Collider.h"
+#include "BroadphasePairs.hpp"
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+namespace Uma_ECS
+{
+    struct Cell
+    {
+        int x, y;
+
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    class SpatialHashGrid
+    {
+    public:
+        static constexpr float DEFAULT_CELL_SIZE = 100.0f;
+
+        explicit SpatialHashGrid(float cellSize = DEFAULT_CELL_SIZE)
+        {
+            SetCellSize(cellSize);
+        }
+
+        // every entity is re-inserted at its next update
+        void SetCellSize(float cellSize)
+        {
+            assert(cellSize > 0.0f && "Error : The cell size of a spatial hash grid must be positive.");
+
+            mCellSize = cellSize;
+            Clear();
+        }
+
+        inline float GetCellSize() const { return mCellSize; }
+
+        inline int WorldToCell(float coord) const
+        {
+            return static_cast<int>(std::floor(coord / mCellSize));
+        }
+
+        // starts a frame, the entities not updated until the next Sweep are dropped
+        inline void BeginFrame() { ++mFrame; }
+
+        // inserts the entity or moves it to the cells covered by box, returns true if the grid was touched
+        // static entities (walls) are never paired together
+        bool Update(Entity entity, const BoundingBox& box, bool isStatic = false)
+        {
+            if (aEntries.size() <= entity)
+            {
+                aEntries.resize(static_cast<size_t>(entity) + 1);
+            }
+
+            Entry& entry = aEntries[entity];
+            entry.frame = mFrame;
+            entry.isStatic = isStatic;
+
+            CellRange range{
+                WorldToCell(box.min.x), WorldToCell(box.min.y),
+                WorldToCell(box.max.x), WorldToCell(box.max.y)
+            };
+
+            if (entry.inGrid)
+            {
+                // still inside the same cells, nothing to do for most bodies
+                if (entry.range == range) return false;
+
+                EraseFromCells(entity, entry.range);
+            }
+            else
+            {
+                entry.inGrid = true;
+                entry.slot = static_cast<Entity>(aTracked.size());
+                aTracked.push_back(entity);
+            }
+
+            entry.range = range;
+            InsertIntoCells(entity, range);
+            return true;
+        }
+
+        void Remove(Entity entity)
+        {
+            if (!Contains(entity)) return;
+
+            Entry& entry = aEntries[entity];
+            EraseFromCells(entity, entry.range);
+            entry.inGrid = false;
+
+            // swap and pop
+            Entity last = aTracked.back();
+            aTracked[entry.slot] = last;
+            aEntries[last].slot = entry.slot;
+            aTracked.pop_back();
+        }
+
+        // drops the entities not updated since BeginFrame
+        void Sweep()
+        {
+            for (size_t i = aTracked.size(); i-- > 0;)
+            {
+                Entity entity = aTracked[i];
+                if (aEntries[entity].frame != mFrame) Remove(entity);
+            }
+        }
+
+        inline bool Contains(Entity entity) const
+        {
+            return entity < aEntries.size() && aEntries[entity].inGrid;
+        }
+
+        // empties the grid, the memory is kept
+        void Clear()
+        {
+            std::fill(aTable.begin(), aTable.end(), EMPTY);
+
+            aCells.clear();
+            aEntries.clear();
+            aTracked.clear();
+        }
+
+        // calls func(const Cell&, const std::vector<Entity>&) for every cell holding at least minCount entities
+        template<typename Func>
+        void ForEachCell(Func&& func, size_t minCount = 1) const
+        {
+            for (const CellBucket& bucket : aCells)
+            {
+                if (bucket.aEntities.size() >= minCount) func(bucket.cell, bucket.aEntities);
+            }
+        }
+
+        // appends every pair of entities sharing at least one cell, once, in no particular order
+        // returns the pairs met while walking the cells, duplicates included
+        size_t GatherPairs(std::vector<PairKey>& out) const
+        {
+            size_t cellPairs = 0;
+
+            for (const CellBucket& bucket : aCells)
+            {
+                const std::vector<Entity>& entities = bucket.aEntities;
+                if (entities.size() < 2) continue;
+
+                cellPairs += entities.size() * (entities.size() - 1) / 2;
+
+                for (size_t i = 0; i < entities.size(); ++i)
+                {
+                    const Entry& a = aEntries[entities[i]];
+
+                    for (size_t j = i + 1; j < entities.size(); ++j)
+                    {
+                        const Entry& b = aEntries[entities[j]];
+                        if (a.isStatic && b.isStatic) continue;
+
+                        // owner cell, both ranges contain it
+                        if (bucket.cell.x != std::max(a.range.minX, b.range.minX) || bucket.cell.y != std::max(a.range.minY, b.range.minY)) continue;
+
+                        out.push_back(MakePairKey(entities[i], entities[j]));
+                    }
+                }
+            }
+
+            return cellPairs;
+        }
+
+        // entities in the cell, nullptr if nothing was ever inserted there
+        const std::vector<Entity>* FindCell(Cell cell) const
+        {
+            uint32_t index = FindIndex(cell);
+            return index != EMPTY ? &aCells[index].aEntities : nullptr;
+        }
+
+        inline size_t EntityCount() const { return aTracked.size(); }
+
+        // cells with a list, emptied ones included
+        inline size_t CellCount() const { return aCells.size(); }
+
+    private:
+        struct CellRange
+        {
+            int minX, minY, maxX, maxY;
+
+            bool operator==(const CellRange& other) const
+            {
+                return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+            }
+        };
+
+        // per entity, indexed by entity id
+        struct Entry
+        {
+            CellRange range{};
+            uint32_t frame = 0;
+            Entity slot = 0; // position in aTracked
+            bool inGrid = false;
+            bool isStatic = false;
+        };
+
+        struct CellBucket
+        {
+            Cell cell;
+            std::vector<Entity> aEntities;
+        };
+
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+
+        // both coordinates in one 64 bit key, multiplied by 2^64 / golden ratio, the top bits index the table
+        inline size_t Hash(Cell cell) const
+        {
+            uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(cell.x))
+                | (static_cast<uint64_t>(static_cast<uint32_t>(cell.y)) << 32);
+
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> mShift);
+        }
+
+        // index of the cell in aCells, EMPTY if not found
+        uint32_t FindIndex(Cell cell) const
+        {
+            if (aTable.empty()) return EMPTY;
+
+            for (size_t i = Hash(cell); ; i = (i + 1) & mMask)
+            {
+                uint32_t index = aTable[i];
+                if (index == EMPTY || aCells[index].cell == cell) return index;
+            }
+        }
+
+        // list of the cell, created if needed
+        std::vector<Entity>& GetOrAddCell(Cell cell)
+        {
+            // load factor kept under a half so probes stay short
+            if ((aCells.size() + 1) * 2 > aTable.size())
+            {
+                Rehash();
+            }
+
+            size_t i = Hash(cell);
+            for (; aTable[i] != EMPTY; i = (i + 1) & mMask)
+            {
+                if (aCells[aTable[i]].cell == cell) return aCells[aTable[i]].aEntities;
+            }
+
+            aTable[i] = static_cast<uint32_t>(aCells.size());
+            aCells.push_back(CellBucket{ cell, {} });
+            return aCells.back().aEntities;
+        }
+
+        // drops the empty cells and grows the table if the remaining ones still need it
+        void Rehash()
+        {
+            aCells.erase(std::remove_if(aCells.begin(), aCells.end(),
+                [](const CellBucket& bucket) { return bucket.aEntities.empty(); }), aCells.end());
+
+            size_t capacity = aTable.empty() ? 64 : aTable.size();
+            while ((aCells.size() + 1) * 2 > capacity) capacity *= 2;
+
+            // a table mostly freed by dropping empty cells shrinks back
+            while (capacity > 64 && (aCells.size() + 1) * 8 < capacity) capacity /= 2;
+
+            aTable.assign(capacity, EMPTY);
+            mMask = capacity - 1;
+            mShift = 64;
+            for (size_t c = capacity; c > 1; c >>= 1) --mShift;
+
+            for (size_t index = 0; index < aCells.size(); ++index)
+            {
+                size_t i = Hash(aCells[index].cell);
+                while (aTable[i] != EMPTY) i = (i + 1) & mMask;
+                aTable[i] = static_cast<uint32_t>(index);
+            }
+        }
+
+        void InsertIntoCells(Entity entity, const CellRange& range)
+        {
+            for (int x = range.minX; x <= range.maxX; ++x)
+            {
+                for (int y = range.minY; y <= range.maxY; ++y)
+                {
+                    GetOrAddCell(Cell{ x, y }).push_back(entity);
+                }
+            }
+        }
+
+        void EraseFromCells(Entity entity, const CellRange& range)
+        {
+            for (int x = range.minX; x <= range.maxX; ++x)
+            {
+                for (int y = range.minY; y <= range.maxY; ++y)
+                {
+                    // the cell exists, the entity was inserted there
+                    std::vector<Entity>& entities = aCells[FindIndex(Cell{ x, y })].aEntities;
+
+                    // cells hold a handful of entities, a scan is cheaper than tracking positions
+                    auto it = std::find(entities.begin(), entities.end(), entity);
+                    *it = entities.back();
+                    entities.pop_back();
+                }
+            }
+        }
+
+        float mCellSize = DEFAULT_CELL_SIZE;
+
+        // open-addressed, index into aCells or EMPTY
+        std::vector<uint32_t> aTable;
+        size_t mMask = 0;
+        unsigned mShift = 64;
+
+        std::vector<CellBucket> aCells;
+
+        std::vector<Entry> aEntries;
+
+        // entities in the grid, for Sweep
+        std::vector<Entity> aTracked;
+
+        uint32_t mFrame = 0;
+    };
+}
@@ -0,0 +1,258 @@
+/*!
+\file   SweepAndPrune.hpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements SweepAndPrune, the sweep and prune broadphase of CollisionSystem, an alternative to SpatialHashGrid.
+
+Keeps the X endpoints of every collider's bounds sorted across frames, an insertion sort restores the nearly sorted
+array and each swap of a min and a max endpoint updates the set of pairs overlapping on X. GatherPairs hands out the
+pairs whose bounds also overlap on Y, static pairs left out, and a scene load's batch is sorted from scratch instead.
+Same frame protocol as SpatialHashGrid: BeginFrame, Update every collider, Sweep drops the ones not updated.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include "../Core/Types.hpp"
+#include "../Components/Collider.h"
+#include "BroadphasePairs.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace Uma_ECS
+{
+    class SweepAndPrune
+    {
+    public:
+        // starts a frame, the entities not updated until the next Sweep are dropped
+        inline void BeginFrame() { ++mFrame; }
+
+        // adds the entity or moves it to box, the endpoints are sorted by Sweep
+        // static entities (walls) are never paired together
+        void Update(Entity entity, const BoundingBox& box, bool isStatic = false)
+        {
+            if (aProxies.size() <= entity)
+            {
+                aProxies.resize(static_cast<size_t>(entity) + 1);
+            }
+
+            Proxy& proxy = aProxies[entity];
+            proxy.box = box;
+            proxy.frame = mFrame;
+            proxy.isStatic = isStatic;
+
+            if (!proxy.inSet)
+            {
+                proxy.inSet = true;
+                ++mCount;
+                ++mAdded;
+
+                // appended after every other endpoint, the sort moves them in from there
+                aEndpoints.push_back(Endpoint{ box.min.x, entity, false });
+                aEndpoints.push_back(Endpoint{ box.max.x, entity, true });
+            }
+        }
+
+        // drops the entities not updated since BeginFrame and sorts the endpoints, updating the overlap set
+        void Sweep()
+        {
+            RemoveStale();
+
+            // the values are copied in the endpoints so the sort reads one array
+            for (Endpoint& endpoint : aEndpoints)
+            {
+                const BoundingBox& box = aProxies[endpoint.entity].box;
+                endpoint.value = endpoint.isMax ? box.max.x : box.min.x;
+            }
+
+            // one insertion per new endpoint costs up to a full pass each, a batch is cheaper sorted from scratch
+            if (mAdded * 8 > mCount)
+            {
+                Rebuild();
+            }
+            else
+            {
+                InsertionSort();
+            }
+
+            mAdded = 0;
+        }
+
+        // appends the pairs overlapping on both axes, in no particular order
+        // returns the pairs overlapping on X the set holds
+        size_t GatherPairs(std::vector<PairKey>& out) const
+        {
+            for (PairKey pair : aOverlaps.GetPairs())
+            {
+                const Proxy& a = aProxies[PairFirst(pair)];
+                const Proxy& b = aProxies[PairSecond(pair)];
+
+                if (a.isStatic && b.isStatic) continue;
+                if (a.box.max.y < b.box.min.y || a.box.min.y > b.box.max.y) continue;
+
+                out.push_back(pair);
+            }
+
+            return aOverlaps.Size();
+        }
+
+        inline bool Contains(Entity entity) const
+        {
+            return entity < aProxies.size() && aProxies[entity].inSet;
+        }
+
+        // empties the broadphase, the memory is kept
+        void Clear()
+        {
+            aProxies.clear();
+            aEndpoints.clear();
+            aOverlaps.Clear();
+
+            mCount = 0;
+            mAdded = 0;
+        }
+
+        inline size_t EntityCount() const { return mCount; }
+
+        // pairs overlapping on X
+        inline size_t OverlapCount() const { return aOverlaps.Size(); }
+
+    private:
+        // per entity, indexed by entity id
+        struct Proxy
+        {
+            BoundingBox box{};
+            uint32_t frame = 0;
+            bool inSet = false;
+            bool isStatic = false;
+        };
+
+        struct Endpoint
+        {
+            float value;
+            Entity entity;
+            bool isMax;
+        };
+
+        // on a tie the min goes first, touching intervals overlap like the narrow phase's test
+        static inline bool Less(const Endpoint& a, const Endpoint& b)
+        {
+            return a.value < b.value || (a.value == b.value && !a.isMax && b.isMax);
+        }
+
+        void InsertionSort()
+        {
+            for (size_t i = 1; i < aEndpoints.size(); ++i)
+            {
+                Endpoint key = aEndpoints[i];
+
+                size_t j = i;
+                while (j > 0)
+                {
+                    const Endpoint& other = aEndpoints[j - 1];
+                    if (!Less(key, other)) break;
+
+                    // a min passing a max to its left starts an overlap, a max passing a min ends one
+                    if (!key.isMax && other.isMax) aOverlaps.Insert(MakePairKey(key.entity, other.entity));
+                    else if (key.isMax && !other.isMax) aOverlaps.Erase(MakePairKey(key.entity, other.entity));
+
+                    aEndpoints[j] = other;
+                    --j;
+                }
+
+                aEndpoints[j] = key;
+            }
+        }
+
+        // full sort then one sweep keeping the intervals open at the current endpoint
+        void Rebuild()
+        {
+            std::sort(aEndpoints.begin(), aEndpoints.end(), Less);
+
+            aOverlaps.Clear();
+
+            aOpen.clear();
+            aOpenSlots.resize(aProxies.size());
+
+            for (const Endpoint& endpoint : aEndpoints)
+            {
+                if (!endpoint.isMax)
+                {
+                    for (Entity open : aOpen) aOverlaps.Insert(MakePairKey(endpoint.entity, open));
+
+                    aOpenSlots[endpoint.entity] = static_cast<Entity>(aOpen.size());
+                    aOpen.push_back(endpoint.entity);
+                }
+                else
+                {
+                    Entity slot = aOpenSlots[endpoint.entity];
+                    Entity last = aOpen.back();
+                    aOpen[slot] = last;
+                    aOpenSlots[last] = slot;
+                    aOpen.pop_back();
+                }
+            }
+        }
+
+        void RemoveStale()
+        {
+            if (mCount == 0) return;
+
+            size_t before = mCount;
+            for (const Endpoint& endpoint : aEndpoints)
+            {
+                Proxy& proxy = aProxies[endpoint.entity];
+                if (!endpoint.isMax && proxy.inSet && proxy.frame != mFrame)
+                {
+                    proxy.inSet = false;
+                    --mCount;
+                }
+            }
+
+            if (mCount == before) return;
+
+            // the endpoints keep their order
+            aEndpoints.erase(std::remove_if(aEndpoints.begin(), aEndpoints.end(),
+                [this](const Endpoint& endpoint) { return !aProxies[endpoint.entity].inSet; }), aEndpoints.end());
+
+            // erasing swaps the last pair in, walking backwards visits every pair once
+            const std::vector<PairKey>& pairs = aOverlaps.GetPairs();
+            for (size_t i = pairs.size(); i-- > 0;)
+            {
+                PairKey pair = pairs[i];
+                if (!aProxies[PairFirst(pair)].inSet || !aProxies[PairSecond(pair)].inSet)
+                {
+                    aOverlaps.Erase(pair);
+                }
+            }
+        }
+
+        std::vector<Proxy> aProxies;
+
+        // both ends of every interval on X, sorted by Sweep
+        std::vector<Endpoint> aEndpoints;
+
+        // pairs overlapping on X
+        PairSet aOverlaps;
+
+        // intervals open during Rebuild's sweep
+        std::vector<Entity> aOpen;
+        std::vector<Entity> aOpenSlots;
+
+        size_t mCount = 0;
+        size_t mAdded = 0;
+        uint32_t mFrame = 0;
+    };
+}
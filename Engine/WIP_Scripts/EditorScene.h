@@ -22,6 +22,7 @@
 // Engine Systems
 #include "Systems/InputSystem.h"
 #include "WIP_Scripts/Test_Input_Events.h"
+#include "WIP_Scripts/Test_ECS_Benchmark.h"
 #include "Systems/Graphics.hpp"
 #include "Systems/Sound.hpp"
 #include "Systems/ResourcesManager.hpp"
@@ -95,10 +96,11 @@ namespace Uma_Engine
             pEventSystem->Subscribe<Uma_Engine::QueryActiveEntitiesEvent>([this](const Uma_Engine::QueryActiveEntitiesEvent& e) { e.mActiveEntityCnt = gCoordinator.GetEntityCount(); });
            
             pEventSystem->Subscribe<Uma_Engine::SaveSceneRequestEvent>([this](const Uma_Engine::SaveSceneRequestEvent& e) { (void)e; gGameSerializer.save(Uma_FilePath::SCENES_DIR + currSceneName); });
-            pEventSystem->Subscribe<Uma_Engine::LoadSceneRequestEvent>([this](const Uma_Engine::LoadSceneRequestEvent& e) { (void)e; gCoordinator.DestroyAllEntities(); gGameSerializer.load(Uma_FilePath::SCENES_DIR + currSceneName); });
+            pEventSystem->Subscribe<Uma_Engine::LoadSceneRequestEvent>([this](const Uma_Engine::LoadSceneRequestEvent& e) { (void)e; gCoordinator.ClearWorld(); gGameSerializer.load(Uma_FilePath::SCENES_DIR + currSceneName); });
             pEventSystem->Subscribe<Uma_Engine::ClearSceneRequestEvent>([this](const Uma_Engine::ClearSceneRequestEvent& e) { (void)e; ResetAll(); });
             pEventSystem->Subscribe<Uma_Engine::StressTestRequestEvent>([this](const Uma_Engine::StressTestRequestEvent& e) { (void)e; StressTest(); });
             pEventSystem->Subscribe<Uma_Engine::ShowEntityInVPRequestEvent>([this](const Uma_Engine::ShowEntityInVPRequestEvent& e) { (void)e; SpawnDefaultEntities(); });
+            pEventSystem->Subscribe<Uma_Engine::ECSBenchmarkRequestEvent>([this](const Uma_Engine::ECSBenchmarkRequestEvent& e) { (void)e; ECSBenchmark::RunAll(); });
 
             pEventSystem->Subscribe<Uma_Engine::ChangeEnemyRotRequestEvent>([this](const Uma_Engine::ChangeEnemyRotRequestEvent& e) { ChangeAllEnemyRot(e.rot); });
             pEventSystem->Subscribe<Uma_Engine::ChangeEnemyXposRequestEvent>([this](const Uma_Engine::ChangeEnemyXposRequestEvent& e) { ChangeAllEnemyXPos(e.xpos); });
@@ -134,6 +136,7 @@ namespace Uma_Engine
             gCoordinator.RegisterComponent<RigidBody>();
             gCoordinator.RegisterComponent<Collider>();
             gCoordinator.RegisterComponent<Sprite>();
+            gCoordinator.RegisterSharedComponent<Sprite>();
             gCoordinator.RegisterComponent<Camera>();
             gCoordinator.RegisterComponent<Player>();
             gCoordinator.RegisterComponent<Enemy>();
@@ -227,6 +230,12 @@ namespace Uma_Engine
 
             cameraSystem->Update(dt);
 
+            // sync point, structural changes recorded by the systems above are applied before rendering
+            gCoordinator.FlushCommands();
+
+            // a slice of the frame restores the pool order scattered by spawning / destroying
+            gCoordinator.Defragment(0.25);
+
             // save to file
             if (pHybridInputSystem->KeyPressed(GLFW_KEY_1))
             {
@@ -238,7 +247,7 @@ namespace Uma_Engine
             // load from file
             if (pHybridInputSystem->KeyPressed(GLFW_KEY_2))
             {
-                gCoordinator.DestroyAllEntities();
+                gCoordinator.ClearWorld();
 
                 std::string filepath = Uma_FilePath::SCENES_DIR + currSceneName;
                 
@@ -254,7 +263,7 @@ namespace Uma_Engine
             // Spawn Default
             if (HybridInputSystem::KeyPressed(GLFW_KEY_4))
             {
-                gCoordinator.DestroyAllEntities();
+                gCoordinator.ClearWorld();
                 SpawnDefaultEntities();
             }
 
@@ -268,6 +277,9 @@ namespace Uma_Engine
                 pSound->playSound(pResourcesManager->GetSound("cave"));
             }
 
+            // after every structural change of the frame (spawns, reloads), rendering reads the transforms published here
+            gCoordinator.SwapBuffers();
+
             pGraphics->ClearBackground(0.2f, 0.3f, 0.3f);
             //pGraphics->DrawBackground(pResourcesManager->GetTexture("background")->tex_id);
             renderingSystem->Update(dt);
@@ -279,7 +291,7 @@ namespace Uma_Engine
 
         void ResetAll()
         {
-            gCoordinator.DestroyAllEntities();
+            gCoordinator.ClearWorld();
 
             using namespace Uma_ECS;
             
@@ -318,7 +330,6 @@ namespace Uma_Engine
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
                     });
 
                 // Create collider with two shapes
@@ -342,7 +353,6 @@ namespace Uma_Engine
                     .autoFitToSprite = false
                     });
 
-                playerCollider.bounds.resize(playerCollider.shapes.size());
                 gCoordinator.AddComponent(player, playerCollider);
             }
 
@@ -375,7 +385,7 @@ namespace Uma_Engine
 
         void SpawnDefaultEntities()
         {
-            gCoordinator.DestroyAllEntities();
+            gCoordinator.ClearWorld();
 
             using namespace Uma_ECS;
 
@@ -409,7 +419,6 @@ namespace Uma_Engine
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
                     });
             }
 
@@ -434,17 +443,15 @@ namespace Uma_Engine
                       .scale = Vec2(1.f, 1.f)
                     });
 
-                std::string texName = "wall_top";
-                gCoordinator.AddComponent(
-                    wall,
-                    Sprite{
-                      .textureName = texName,
+                // walls share one sprite per texture, the renderer draws each group as one batch
+                Sprite wallSprite{
+                      .textureName = "wall_top",
                       .renderLayer = RL_WALL,
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
-                    });
+                    };
+                gCoordinator.SetSharedComponent(wall, wallSprite);
 
                 // Create collider with two shapes
                 Collider wallCollider;
@@ -458,52 +465,48 @@ namespace Uma_Engine
                     .autoFitToSprite = true  // Will be 128x128 (64*2 scale)
                 };
 
-                wallCollider.bounds.resize(wallCollider.shapes.size());
                 gCoordinator.AddComponent(wall, wallCollider);
 
+                std::vector<Entity> walls = gCoordinator.Instantiate(wall, 5 + 6 + 5);
+                size_t next = 0;
+
                 for (size_t i = 0; i < 5; i++)
                 {
-                    Entity tmp = gCoordinator.DuplicateEntity(wall);
+                    Entity tmp = walls[next++];
 
                     Transform& tf = gCoordinator.GetComponent<Transform>(tmp);
 
                     tf.position = Vec2(20 + (i * 5), 0);
 
-                    Sprite& sr = gCoordinator.GetComponent<Sprite>(tmp);
-
-                    // set texture randomly
-                    sr.textureName = "wall_btm";
-                    sr.texture = pResourcesManager->GetTexture(sr.textureName);
+                    // moves the wall to the group of that texture
+                    wallSprite.textureName = "wall_btm";
+                    gCoordinator.SetSharedComponent(tmp, wallSprite);
                 }
 
                 for (size_t i = 0; i < 6; i++)
                 {
-                    Entity tmp = gCoordinator.DuplicateEntity(wall);
+                    Entity tmp = walls[next++];
 
                     Transform& tf = gCoordinator.GetComponent<Transform>(tmp);
 
                     tf.position = Vec2(15 + (6 * 5), 5 + (i * 5));
 
-                    Sprite& sr = gCoordinator.GetComponent<Sprite>(tmp);
-
-                    // set texture randomly
-                    sr.textureName = "wall_right";
-                    sr.texture = pResourcesManager->GetTexture(sr.textureName);
+                    // moves the wall to the group of that texture
+                    wallSprite.textureName = "wall_right";
+                    gCoordinator.SetSharedComponent(tmp, wallSprite);
                 }
 
                 for (size_t i = 0; i < 5; i++)
                 {
-                    Entity tmp = gCoordinator.DuplicateEntity(wall);
+                    Entity tmp = walls[next++];
 
                     Transform& tf = gCoordinator.GetComponent<Transform>(tmp);
 
                     tf.position = Vec2(20 + (i * 5), 15 + (4 * 5));
 
-                    Sprite& sr = gCoordinator.GetComponent<Sprite>(tmp);
-
-                    // set texture randomly
-                    sr.textureName = "wall_top";
-                    sr.texture = pResourcesManager->GetTexture(sr.textureName);
+                    // moves the wall to the group of that texture
+                    wallSprite.textureName = "wall_top";
+                    gCoordinator.SetSharedComponent(tmp, wallSprite);
                 }
             }
 
@@ -528,23 +531,24 @@ namespace Uma_Engine
                       .scale = Vec2(2.f, 2.f)
                     });
 
-                std::string texName = "floor_tatami";
-                gCoordinator.AddComponent(
+                // every floor tile references the same sprite
+                gCoordinator.SetSharedComponent(
                     floor,
                     Sprite{
-                      .textureName = texName,
+                      .textureName = "floor_tatami",
                       .renderLayer = RL_WALL,
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
                     });
 
+                std::vector<Entity> floors = gCoordinator.Instantiate(floor, 5 * 3);
+
                 for (size_t i = 0; i < 5; i++)
                 {
                     for (size_t j = 0; j < 3; j++)
                     {
-                        Entity tmp = gCoordinator.DuplicateEntity(floor);
+                        Entity tmp = floors[i * 3 + j];
 
                         Transform& tf = gCoordinator.GetComponent<Transform>(tmp);
 
@@ -597,7 +601,6 @@ namespace Uma_Engine
                           .flipX = false,
                           .flipY = false,
                           .UseNativeSize = true,
-                          .texture = pResourcesManager->GetTexture(texName),
                         });
 
                     // Create collider with two shapes
@@ -623,7 +626,6 @@ namespace Uma_Engine
                         .autoFitToSprite = false
                     });
 
-                    enemyCollider.bounds.resize(enemyCollider.shapes.size());
                     gCoordinator.AddComponent(enemy, enemyCollider);
                 }
 
@@ -641,7 +643,6 @@ namespace Uma_Engine
                     Sprite& sr = gCoordinator.GetComponent<Sprite>(tmp);
 
                     sr.textureName = (i > 1250) ? "pink_enemy" : "enemy";
-                    sr.texture = pResourcesManager->GetTexture(sr.textureName);
                 }*/
             }
 
@@ -681,7 +682,6 @@ namespace Uma_Engine
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
                     });
 
                 // Create collider with two shapes
@@ -705,7 +705,6 @@ namespace Uma_Engine
                     .autoFitToSprite = false
                     });
 
-                playerCollider.bounds.resize(playerCollider.shapes.size());
                 gCoordinator.AddComponent(player, playerCollider);
             }
 
@@ -783,7 +782,6 @@ namespace Uma_Engine
                           .flipX = false,
                           .flipY = false,
                           .UseNativeSize = true,
-                          .texture = pResourcesManager->GetTexture(texName),
                         });
 
                     // Create collider with two shapes
@@ -809,7 +807,6 @@ namespace Uma_Engine
                         .autoFitToSprite = false
                         });
 
-                    enemyCollider.bounds.resize(enemyCollider.shapes.size());
                     gCoordinator.AddComponent(enemy, enemyCollider);
                 }
 
@@ -835,7 +832,6 @@ namespace Uma_Engine
 
                 // set texture randomly
                 sr.textureName = (randPositionX(generator) > 0.f) ? "pink_enemy" : "enemy";
-                sr.texture = pResourcesManager->GetTexture(sr.textureName);
             }
         }
 
@@ -856,7 +852,7 @@ namespace Uma_Engine
 
         void StressTest()
         {
-            gCoordinator.DestroyAllEntities();
+            gCoordinator.ClearWorld();
 
             using namespace Uma_ECS;
 
@@ -872,40 +868,6 @@ namespace Uma_Engine
                 {
                     enemy = gCoordinator.CreateEntity();
 
-                    gCoordinator.AddComponent(
-                        enemy,
-                        Enemy{
-                            .mSpeed = 1.f
-                        });
-
-                    gCoordinator.AddComponent(
-                        enemy,
-                        RigidBody{
-                          .velocity = Vec2(0.0f, 0.0f),
-                          .acceleration = Vec2(0.0f, 0.0f),
-                          .accel_strength = 200,
-                          .fric_coeff = 100
-                        });
-
-                    gCoordinator.AddComponent(
-                        enemy,
-                        Transform{
-                          .position = Vec2(-10, 0),
-                          .rotation = Vec2(0, 0),
-                          .scale = Vec2(1.f, 1.f)
-                        });
-
-                    std::string texName = "pink_enemy";
-                    gCoordinator.AddComponent(
-                        enemy,
-                        Sprite{
-                          .textureName = texName,
-                          .flipX = false,
-                          .flipY = false,
-                          .UseNativeSize = true,
-                          .texture = pResourcesManager->GetTexture(texName),
-                        });
-
                     // Create collider with two shapes
                     Collider enemyCollider;
 
@@ -929,23 +891,42 @@ namespace Uma_Engine
                         .autoFitToSprite = false
                         });
 
-                    enemyCollider.bounds.resize(enemyCollider.shapes.size());
-                    gCoordinator.AddComponent(enemy, enemyCollider);
+
+                    std::string texName = "pink_enemy";
+
+                    // all components in one go, the systems are updated once
+                    gCoordinator.AddComponents(
+                        enemy,
+                        Enemy{
+                            .mSpeed = 1.f
+                        },
+                        RigidBody{
+                          .velocity = Vec2(0.0f, 0.0f),
+                          .acceleration = Vec2(0.0f, 0.0f),
+                          .accel_strength = 200,
+                          .fric_coeff = 100
+                        },
+                        Transform{
+                          .position = Vec2(-10, 0),
+                          .rotation = Vec2(0, 0),
+                          .scale = Vec2(1.f, 1.f)
+                        },
+                        Sprite{
+                          .textureName = texName,
+                          .flipX = false,
+                          .flipY = false,
+                          .UseNativeSize = true,
+                        },
+                        enemyCollider);
                 }
 
-                // using 1 enemy to duplicate 2500 times and rand its transform
-                for (size_t i = 0; i < 10000 - 3; i++)
+                // using 1 enemy to instantiate the rest in one batch and rand its transform
+                // the copies share the texture of the template
+                for (Entity tmp : gCoordinator.Instantiate(enemy, 10000 - 3))
                 {
-                    Entity tmp = gCoordinator.DuplicateEntity(enemy);
-
                     Transform& tf = gCoordinator.GetComponent<Transform>(tmp);
 
                     tf.position = Vec2(randPositionX(generator), randPositionY(generator));
-
-                    Sprite& sr = gCoordinator.GetComponent<Sprite>(tmp);
-
-                    //sr.textureName = (i > 1250) ? "pink_enemy" : "enemy";
-                    sr.texture = pResourcesManager->GetTexture(sr.textureName);
                 }
             }
 
@@ -984,7 +965,6 @@ namespace Uma_Engine
                       .flipX = false,
                       .flipY = false,
                       .UseNativeSize = true,
-                      .texture = pResourcesManager->GetTexture(texName),
                     });
 
                 // Create collider with two shapes
@@ -1008,7 +988,6 @@ namespace Uma_Engine
                     .autoFitToSprite = false
                     });
 
-                playerCollider.bounds.resize(playerCollider.shapes.size());
                 gCoordinator.AddComponent(player, playerCollider);
             }
 
@@ -1046,7 +1025,7 @@ namespace Uma_Engine
 
             for (size_t i = 0; i < eArray.Size(); i++)
             {
-                auto& tf = tfArray.GetData(eArray.GetEntity(i));
+                auto& tf = tfArray.GetMutable(eArray.GetEntity(i));
 
                 //tf.scale = //Vec2{randScale(generator), randScale(generator)} * scale;
 
@@ -1066,7 +1045,7 @@ namespace Uma_Engine
 
             for (size_t i = 0; i < eArray.Size(); i++)
             {
-                auto& rb = rbArray.GetData(eArray.GetEntity(i));
+                auto& rb = rbArray.GetMutable(eArray.GetEntity(i));
 
                 rb.acceleration = Vec2{ 5000.f * xPos, 0 };
             }
@@ -1084,7 +1063,7 @@ namespace Uma_Engine
 
             for (size_t i = 0; i < eArray.Size(); i++)
             {
-                auto& tf = tfArray.GetData(eArray.GetEntity(i));
+                auto& tf = tfArray.GetMutable(eArray.GetEntity(i));
 
                 tf.scale = Vec2{randScale(generator), randScale(generator)} * scale;
             }
@@ -1100,7 +1079,7 @@ namespace Uma_Engine
             for (size_t i = 0; i < tfArray.Size(); i++)
             {
                 if (!cArray.Has(tfArray.GetEntity(i))) continue;
-                auto& c = cArray.GetData(tfArray.GetEntity(i));
+                auto& c = cArray.GetMutable(tfArray.GetEntity(i));
 
                 c.showBBox = isShow;
             }
@@ -1110,7 +1089,11 @@ namespace Uma_Engine
 
         void LoadPrefab()
         {
-            gGameSerializer.loadPrefab(Uma_FilePath::PREFAB_DIR + "enemy.json");
+            // the file is converted on the first request, later spawns copy the cached template
+            if (const Prefab* enemy = gCoordinator.LoadPrefab(Uma_FilePath::PREFAB_DIR + "enemy.json"))
+            {
+                gCoordinator.Instantiate(*enemy, 1);
+            }
         }
 	  };
 }
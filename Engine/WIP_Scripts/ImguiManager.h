@@ -104,7 +104,9 @@ namespace Uma_Engine
                 pEventSystem->Subscribe<DebugLogEvent>([this](const DebugLogEvent& e) { AddConsoleLog(e.message); });
 
                 pEventSystem->Subscribe<EntityCreatedEvent>([this](const EntityCreatedEvent& e) { mEntityCount = e.entityCnt; });
+                pEventSystem->Subscribe<EntitiesCreatedEvent>([this](const EntitiesCreatedEvent& e) { mEntityCount = e.entityCnt; });
                 pEventSystem->Subscribe<EntityDestroyedEvent>([this](const EntityDestroyedEvent& e) { mEntityCount = e.entityCnt; });
+                pEventSystem->Subscribe<EntitiesDestroyedEvent>([this](const EntitiesDestroyedEvent& e) { mEntityCount = e.entityCnt; });
 
                 m_initialized = true;
             }
@@ -364,6 +366,10 @@ namespace Uma_Engine
                 {
                     pEventSystem->Emit<ShowEntityInVPRequestEvent>();
                 }
+                if (ImGui::Button("Run ECS Benchmark", { 160, 50 }))
+                {
+                    pEventSystem->Emit<ECSBenchmarkRequestEvent>();
+                }
                 
                 ImGui::End();
             }
@@ -0,0 +1,1693 @@
+﻿/*!
+\file   Test_ECS_Benchmark.cpp
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Implements the headless ECS benchmarks declared in Test_ECS_Benchmark.h.
+
+Spawns StressTest-like scenes in a private Coordinator, times the interesting ECS paths with
+std::chrono::steady_clock and logs the averaged results through the Debugger.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#include "Test_ECS_Benchmark.h"
+
+#include "ECS/Core/Coordinator.hpp"
+#include "ECS/Core/SystemManager.hpp"
+#include "ECS/Core/EntityCommandBuffer.hpp"
+#include "ECS/Systems/PhysicsSystem.hpp"
+#include "ECS/Systems/SpatialHashGrid.hpp"
+#include "ECS/Systems/SweepAndPrune.hpp"
+#include "ECS/Systems/CollisionSystem.hpp"
+#include "ECS/Systems/ShapePairBatch.hpp"
+
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/RigidBody.h"
+#include "ECS/Components/Collider.h"
+#include "ECS/Components/Sprite.h"
+#include "ECS/Components/Camera.h"
+#include "ECS/Components/Player.h"
+#include "ECS/Components/Enemy.h"
+
+#include "Core/EventSystem.h"
+#include "Debugging/Debugger.hpp"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <typeindex>
+
+namespace
+{
+    using namespace Uma_ECS;
+
+    template<typename Func>
+    double MeasureMs(Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    void LogResult(const std::string& name, double ms, size_t iterations = 1)
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(4) << "[ECS Benchmark] " << name << " : " << (ms / static_cast<double>(iterations)) << " ms";
+        if (iterations > 1)
+        {
+            ss << " (avg of " << iterations << ")";
+        }
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+    }
+
+    // same registration order as EditorScene
+    void RegisterComponents(Coordinator& coordinator)
+    {
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<RigidBody>();
+        coordinator.RegisterComponent<Collider>();
+        coordinator.RegisterComponent<Sprite>();
+        coordinator.RegisterComponent<Camera>();
+        coordinator.RegisterComponent<Player>();
+        coordinator.RegisterComponent<Enemy>();
+    }
+
+    // a private EventSystem and Coordinator with the scene's components registered, every benchmark runs on its own
+    struct BenchmarkScene
+    {
+        Uma_Engine::EventSystem eventSystem;
+        Coordinator coordinator;
+
+        explicit BenchmarkScene(StorageMode mode = StorageMode::SM_Pooled)
+        {
+            coordinator.Init(&eventSystem, mode);
+            RegisterComponents(coordinator);
+        }
+
+        // whatever the benchmark left alive goes before the EventSystem does
+        ~BenchmarkScene()
+        {
+            coordinator.ClearWorld();
+            eventSystem.ClearAll();
+        }
+    };
+
+    // mirrors the enemy template used by EditorScene::StressTest
+    Entity CreateEnemyTemplate(Coordinator& coordinator)
+    {
+        Entity enemy = coordinator.CreateEntity();
+
+        coordinator.AddComponent(enemy, Enemy{ .mSpeed = 1.f });
+
+        coordinator.AddComponent(
+            enemy,
+            RigidBody{
+              .velocity = Vec2(0.0f, 0.0f),
+              .acceleration = Vec2(0.0f, 0.0f),
+              .accel_strength = 200,
+              .fric_coeff = 100
+            });
+
+        coordinator.AddComponent(
+            enemy,
+            Transform{
+              .position = Vec2(-10, 0),
+              .rotation = Vec2(0, 0),
+              .scale = Vec2(1.f, 1.f)
+            });
+
+        coordinator.AddComponent(
+            enemy,
+            Sprite{
+              .textureName = "pink_enemy",
+              .flipX = false,
+              .flipY = false,
+              .UseNativeSize = true,
+            });
+
+        Collider enemyCollider;
+
+        enemyCollider.shapes[0] = ColliderShape{
+            .size = Vec2(3.f, 3.f),
+            .offset = Vec2(0.f, 1.f),
+            .purpose = ColliderPurpose::Physics,
+            .layer = CL_ENEMY,
+            .colliderMask = CL_PLAYER | CL_PROJECTILE,
+            .isActive = true,
+            .autoFitToSprite = false
+        };
+
+        enemyCollider.shapes.push_back(ColliderShape{
+            .size = Vec2(2.f, 0.5f),
+            .offset = Vec2(0.f, -2.f),
+            .purpose = ColliderPurpose::Environment,
+            .layer = CL_WALL,
+            .colliderMask = CL_WALL,
+            .isActive = true,
+            .autoFitToSprite = false
+            });
+
+        coordinator.AddComponent(enemy, enemyCollider);
+
+        return enemy;
+    }
+
+    void SpawnStressTest(Coordinator& coordinator, size_t entityCount)
+    {
+        std::default_random_engine generator;
+        std::uniform_real_distribution<float> randPositionX(-1920.f, 1920.f);
+        std::uniform_real_distribution<float> randPositionY(-1080.f, 1080.f);
+        std::uniform_real_distribution<float> randVelocity(-50.f, 50.f);
+
+        Entity enemy = CreateEnemyTemplate(coordinator);
+
+        for (size_t i = 1; i < entityCount; ++i)
+        {
+            Entity tmp = coordinator.DuplicateEntity(enemy);
+
+            Transform& tf = coordinator.GetComponent<Transform>(tmp);
+            tf.position = Vec2(randPositionX(generator), randPositionY(generator));
+
+            RigidBody& rb = coordinator.GetComponent<RigidBody>(tmp);
+            rb.velocity = Vec2(randVelocity(generator), randVelocity(generator));
+            rb.fric_coeff = 0.1f;
+        }
+    }
+
+    // same integration as PhysicsSystem::Update
+    inline void IntegrateBody(Transform& tf, RigidBody& rb, float dt)
+    {
+        tf.rotation.x += tf.rotation.y;
+
+        rb.velocity += rb.acceleration * dt;
+        rb.velocity *= std::exp(-rb.fric_coeff * dt);
+
+        const float epsilon = 0.01f;
+        if (std::abs(rb.velocity.x) < epsilon) rb.velocity.x = 0.f;
+        if (std::abs(rb.velocity.y) < epsilon) rb.velocity.y = 0.f;
+
+        tf.position += rb.velocity * dt;
+    }
+
+    // position update only, keeps the loop body cheap so the iteration cost itself shows up
+    inline void MoveBody(Transform& tf, const RigidBody& rb, float dt)
+    {
+        tf.position += rb.velocity * dt;
+    }
+
+    // same bounds computation as CollisionSystem::UpdateBoundingBoxes without the sprite lookup, from the shape list
+    inline void UpdateBounds(const Transform& tf, const Collider& c, std::array<BoundingBox, MAX_COLLIDER_SHAPES>& out)
+    {
+        for (size_t i = 0; i < c.shapes.size() && i < MAX_COLLIDER_SHAPES; ++i)
+        {
+            const auto& shape = c.shapes[i];
+            if (!shape.isActive) continue;
+
+            Vec2 scaledSize = Vec2{ shape.size.x * tf.scale.x, shape.size.y * tf.scale.y };
+            Vec2 worldPosition = tf.position + Vec2{ shape.offset.x * tf.scale.x, shape.offset.y * tf.scale.y };
+
+            Vec2 halfSize = scaledSize * 0.5f;
+            out[i].min = worldPosition - halfSize;
+            out[i].max = worldPosition + halfSize;
+        }
+    }
+
+    // same computation from the hot record only, what CollisionSystem runs after the split (inline shapes)
+    inline void UpdateBounds(const Transform& tf, ColliderHot& c)
+    {
+        for (size_t i = 0; i < c.count && i < INLINE_COLLIDER_SHAPES; ++i)
+        {
+            if (!c.IsActive(i)) continue;
+
+            ColliderShapeHot& shape = c.shapes[i];
+            Vec2 scaledSize = Vec2{ shape.size.x * tf.scale.x, shape.size.y * tf.scale.y };
+            Vec2 worldPosition = tf.position + Vec2{ shape.offset.x * tf.scale.x, shape.offset.y * tf.scale.y };
+
+            Vec2 halfSize = scaledSize * 0.5f;
+            shape.bounds.min = worldPosition - halfSize;
+            shape.bounds.max = worldPosition + halfSize;
+        }
+    }
+
+    // Collider and Sprite as they were before the hot / cold split, runtime fields interleaved with the authoring data
+    struct LegacyCollider
+    {
+        std::vector<ColliderShape> shapes;
+        LayerMask defaultLayer = CL_DEFAULT;
+        LayerMask defaultMask = CL_ALL;
+        bool showBBox = false;
+        std::vector<BoundingBox> bounds;
+
+        void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const {}
+        void Deserialize(const rapidjson::Value&) {}
+    };
+
+    struct LegacySprite
+    {
+        std::string textureName{};
+        LayerMask renderLayer = RL_NONE;
+        bool flipX{};
+        bool flipY{};
+        bool UseNativeSize{};
+        Uma_Engine::Texture* texture = nullptr;
+
+        void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const {}
+        void Deserialize(const rapidjson::Value&) {}
+    };
+
+    // the per frame grid CollisionSystem used to build, hash included
+    struct LegacyCellHash
+    {
+        std::size_t operator()(const Cell& c) const
+        {
+            return (std::hash<int>()(c.x) ^ (std::hash<int>()(c.y) << 1));
+        }
+    };
+
+    using LegacyGrid = std::unordered_map<Cell, std::vector<Entity>, LegacyCellHash>;
+
+    void InsertIntoLegacyGrid(LegacyGrid& grid, Entity entity, const BoundingBox& box, float cellSize)
+    {
+        int minX = static_cast<int>(std::floor(box.min.x / cellSize));
+        int maxX = static_cast<int>(std::floor(box.max.x / cellSize));
+        int minY = static_cast<int>(std::floor(box.min.y / cellSize));
+        int maxY = static_cast<int>(std::floor(box.max.y / cellSize));
+
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                grid[Cell{ x, y }].push_back(entity);
+            }
+        }
+    }
+
+    // stand-ins for the five systems EditorScene registers, only their membership matters here
+    class BenchPlayerControllerSystem : public ECSSystem {};
+    class BenchPhysicsSystem : public ECSSystem {};
+    class BenchCollisionSystem : public ECSSystem {};
+    class BenchRenderingSystem : public ECSSystem {};
+    class BenchCameraSystem : public ECSSystem {};
+
+    // same system signatures as EditorScene, returned in registration order
+    std::vector<Signature> MakeSceneSystemSignatures(Coordinator& coordinator)
+    {
+        std::vector<Signature> signatures(5);
+
+        signatures[0].set(coordinator.GetComponentType<RigidBody>());
+        signatures[0].set(coordinator.GetComponentType<Transform>());
+        signatures[0].set(coordinator.GetComponentType<Player>());
+
+        signatures[1].set(coordinator.GetComponentType<RigidBody>());
+        signatures[1].set(coordinator.GetComponentType<Transform>());
+
+        signatures[2].set(coordinator.GetComponentType<RigidBody>());
+        signatures[2].set(coordinator.GetComponentType<Transform>());
+        signatures[2].set(coordinator.GetComponentType<Collider>());
+
+        signatures[3].set(coordinator.GetComponentType<Sprite>());
+        signatures[3].set(coordinator.GetComponentType<Transform>());
+
+        signatures[4].set(coordinator.GetComponentType<Camera>());
+        signatures[4].set(coordinator.GetComponentType<Transform>());
+
+        return signatures;
+    }
+
+    template<typename Manager>
+    void RegisterSceneSystems(Manager& manager, const std::vector<Signature>& signatures)
+    {
+        manager.template RegisterSystem<BenchPlayerControllerSystem>();
+        manager.template RegisterSystem<BenchPhysicsSystem>();
+        manager.template RegisterSystem<BenchCollisionSystem>();
+        manager.template RegisterSystem<BenchRenderingSystem>();
+        manager.template RegisterSystem<BenchCameraSystem>();
+
+        if constexpr (std::is_same_v<Manager, Uma_ECS::SystemManager>)
+        {
+            manager.template SetSignature<BenchPlayerControllerSystem>(signatures[0]);
+            manager.template SetSignature<BenchPhysicsSystem>(signatures[1]);
+            manager.template SetSignature<BenchCollisionSystem>(signatures[2]);
+            manager.template SetSignature<BenchRenderingSystem>(signatures[3]);
+            manager.template SetSignature<BenchCameraSystem>(signatures[4]);
+        }
+        else
+        {
+            manager.template SetSystemSignature<BenchPlayerControllerSystem>(signatures[0]);
+            manager.template SetSystemSignature<BenchPhysicsSystem>(signatures[1]);
+            manager.template SetSystemSignature<BenchCollisionSystem>(signatures[2]);
+            manager.template SetSystemSignature<BenchRenderingSystem>(signatures[3]);
+            manager.template SetSystemSignature<BenchCameraSystem>(signatures[4]);
+        }
+    }
+
+    const char* SimdPathName(SimdPath path)
+    {
+        switch (path)
+        {
+        case SimdPath::SP_SSE2: return "SSE2";
+        case SimdPath::SP_AVX2: return "AVX2";
+        default: return "scalar";
+        }
+    }
+
+    // one side of a shape pair as the narrow phase used to read it, one record per shape
+    struct ShapeSide
+    {
+        BoundingBox box;
+        LayerMask layer;
+        LayerMask mask;
+        ColliderPurpose purpose;
+    };
+
+    // random shape pairs near each other, always the same for a given count
+    std::vector<std::pair<ShapeSide, ShapeSide>> MakeShapePairs(size_t shapePairCount)
+    {
+        // whole units, so many boxes touch exactly and every path must agree on the edges
+        std::default_random_engine generator(25);
+        std::uniform_int_distribution<int> randPosition(-2000, 2000);
+        std::uniform_int_distribution<int> randSize(1, 40);
+        std::uniform_int_distribution<int> randOffset(-45, 45);
+        std::uniform_int_distribution<int> randKind(0, 5);
+
+        const LayerMask layers[] = { CL_PLAYER, CL_ENEMY, CL_WALL, CL_PROJECTILE, CL_PICKUP, CL_DEFAULT };
+        const LayerMask masks[] = { CL_ENEMY | CL_WALL, CL_PLAYER | CL_ENEMY | CL_WALL, CL_PLAYER | CL_ENEMY, CL_ENEMY | CL_WALL, CL_PLAYER, CL_ALL };
+        const ColliderPurpose purposes[] = { ColliderPurpose::Physics, ColliderPurpose::Physics, ColliderPurpose::Environment,
+            ColliderPurpose::Trigger, ColliderPurpose::Trigger, ColliderPurpose::Physics };
+
+        auto randomSide = [&](Vec2 near)
+            {
+                int kind = randKind(generator);
+                Vec2 min(near.x + static_cast<float>(randOffset(generator)), near.y + static_cast<float>(randOffset(generator)));
+                Vec2 size(static_cast<float>(randSize(generator)), static_cast<float>(randSize(generator)));
+                return ShapeSide{ BoundingBox{ min, min + size }, layers[kind], masks[kind], purposes[kind] };
+            };
+
+        std::vector<std::pair<ShapeSide, ShapeSide>> shapePairs;
+        shapePairs.reserve(shapePairCount);
+        for (size_t i = 0; i < shapePairCount; ++i)
+        {
+            Vec2 near(static_cast<float>(randPosition(generator)), static_cast<float>(randPosition(generator)));
+            shapePairs.emplace_back(randomSide(near), randomSide(near));
+        }
+
+        return shapePairs;
+    }
+
+    // the old narrow phase, one pair at a time with a branch per filter
+    void TestOneByOne(const std::vector<std::pair<ShapeSide, ShapeSide>>& shapePairs, std::vector<uint32_t>& hits)
+    {
+        auto purposesCollide = [](ColliderPurpose p1, ColliderPurpose p2)
+            {
+                if (p1 == ColliderPurpose::Trigger || p2 == ColliderPurpose::Trigger) return true;
+                if (p1 == ColliderPurpose::Physics) return p2 == ColliderPurpose::Physics || p2 == ColliderPurpose::Environment;
+                if (p2 == ColliderPurpose::Physics) return p1 == ColliderPurpose::Physics || p1 == ColliderPurpose::Environment;
+                return false;
+            };
+
+        hits.clear();
+        for (size_t i = 0; i < shapePairs.size(); ++i)
+        {
+            const ShapeSide& a = shapePairs[i].first;
+            const ShapeSide& b = shapePairs[i].second;
+
+            if (!((a.layer & b.mask) && (a.mask & b.layer))) continue;
+            if (!purposesCollide(a.purpose, b.purpose)) continue;
+            if (a.box.max.x < b.box.min.x || a.box.min.x > b.box.max.x || a.box.max.y < b.box.min.y || a.box.min.y > b.box.max.y) continue;
+
+            hits.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    void GatherShapePairs(const std::vector<std::pair<ShapeSide, ShapeSide>>& shapePairs, ShapePairBatch& batch)
+    {
+        batch.Clear();
+        for (const auto& [a, b] : shapePairs)
+        {
+            batch.Add(a.box, a.layer, a.mask, a.purpose, b.box, b.layer, b.mask, b.purpose);
+        }
+    }
+
+    // runs CollisionSystem::Update on a StressTest scene whose enemies push each other, on the given narrow phase path
+    // adds the time spent in Update to ms and the contacts found to contacts, returns a checksum of the final positions
+    double RunCollisionScene(SimdPath path, size_t entityCount, int frames, double& ms, size_t& contacts)
+    {
+        const float dt = 1.f / 60.f;
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+        coordinator.RegisterSharedComponent<Sprite>();
+
+        auto collision = coordinator.RegisterSystem<CollisionSystem>();
+        {
+            Signature sign;
+            sign.set(coordinator.GetComponentType<RigidBody>());
+            sign.set(coordinator.GetComponentType<Transform>());
+            sign.set(coordinator.GetComponentType<Collider>());
+            coordinator.SetSystemSignature<CollisionSystem>(sign);
+        }
+        collision->Init(&coordinator);
+        collision->SetNarrowPhasePath(path);
+
+        SpawnStressTest(coordinator, entityCount);
+
+        // every pair of shapes (body, feet) goes through the batch and the layer / purpose filters drop the feet pairs
+        auto& cArray = coordinator.GetComponentArray<Collider>();
+        for (auto [entity, c] : coordinator.View<Collider>())
+        {
+            if (c.shapes[0].layer != CL_ENEMY) continue;
+
+            c.shapes[0].colliderMask |= CL_ENEMY;
+            cArray.MarkChanged(entity);
+        }
+
+        scene.eventSystem.ProcessEvents();
+
+        auto& tfArray = coordinator.GetComponentArray<Transform>();
+
+        for (int f = 0; f < frames; ++f)
+        {
+            for (auto [entity, tf, rb] : coordinator.View<Transform, RigidBody>())
+            {
+                MoveBody(tf, rb, dt);
+                tfArray.MarkChanged(entity);
+            }
+
+            ms += MeasureMs([&] { collision->Update(dt); });
+            contacts += collision->GetBroadphaseStats().contacts;
+        }
+
+        double checksum = 0.0;
+        for (auto [entity, tf] : coordinator.View<Transform>())
+        {
+            checksum += tf.position.x * 1.5 + tf.position.y;
+        }
+        return checksum;
+    }
+
+    // heap allocations made through CountingAllocator, the pools' own growth is not counted
+    size_t gProbeAllocations = 0;
+
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(size_t n)
+        {
+            ++gProbeAllocations;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U>&) const { return true; }
+    };
+
+    // stands in for Collider / Sprite, owns heap memory and counts every allocation of it
+    struct AllocProbe
+    {
+        std::vector<int, CountingAllocator<int>> aData;
+
+        void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const {}
+        void Deserialize(const rapidjson::Value&) {}
+    };
+
+    // logs the time and the probe allocations of func, returns the allocation count
+    template<typename Func>
+    size_t LogAllocations(const std::string& name, Func&& func)
+    {
+        size_t before = gProbeAllocations;
+        double ms = MeasureMs(func);
+        size_t allocations = gProbeAllocations - before;
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(4) << "[ECS Check] " << name << " : " << ms << " ms, " << allocations << " component allocations";
+        Uma_Engine::Debugger::Log(Uma_Engine::WarningLevel::eInfo, ss.str());
+
+        return allocations;
+    }
+}
+
+namespace Uma_Engine
+{
+    void ECSBenchmark::RunAll()
+    {
+        RunStorageBenchmark();
+        RunTypeLookupBenchmark();
+        RunViewBenchmark();
+        RunSystemMembershipBenchmark();
+        RunSpawnBenchmark();
+        RunHotColdBenchmark();
+        RunDefragmentBenchmark();
+        RunPrefabBenchmark();
+        RunSpatialHashBenchmark(2500);
+        RunSpatialHashBenchmark(10000);
+        RunSweepAndPruneBenchmark();
+        RunNarrowPhaseBenchmark();
+
+        CheckComponentMoves();
+        CheckNarrowPhasePaths();
+    }
+
+    void ECSBenchmark::RunStorageBenchmark(size_t entityCount, int frames)
+    {
+        const float dt = 1.f / 60.f;
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Storage : pools vs archetype chunks, entities = " + std::to_string(entityCount));
+
+        // per-type pools, this is what the game runs on
+        {
+            BenchmarkScene scene(StorageMode::SM_Pooled);
+            Coordinator& coordinator = scene.coordinator;
+
+            auto physics = coordinator.RegisterSystem<PhysicsSystem>();
+            {
+                Signature sign;
+                sign.set(coordinator.GetComponentType<RigidBody>());
+                sign.set(coordinator.GetComponentType<Transform>());
+                coordinator.SetSystemSignature<PhysicsSystem>(sign);
+            }
+            physics->Init(&coordinator);
+
+            LogResult("pooled spawn", MeasureMs([&] { SpawnStressTest(coordinator, entityCount); }));
+
+            LogResult("pooled PhysicsSystem::Update (GetData per entity)", MeasureMs([&]
+                {
+                    for (int f = 0; f < frames; ++f) physics->Update(dt);
+                }), frames);
+
+            LogResult("pooled ForEach<Transform, RigidBody>", MeasureMs([&]
+                {
+                    for (int f = 0; f < frames; ++f)
+                        coordinator.ForEach<Transform, RigidBody>([dt](Entity, Transform& tf, RigidBody& rb) { IntegrateBody(tf, rb, dt); });
+                }), frames);
+
+            // both layouts compute the bounds from the shape list into the same scratch record
+            std::array<BoundingBox, MAX_COLLIDER_SHAPES> bounds{};
+
+            LogResult("pooled ForEach<Transform, Collider> bounds", MeasureMs([&]
+                {
+                    for (int f = 0; f < frames; ++f)
+                        coordinator.ForEach<Transform, Collider>([&bounds](Entity, Transform& tf, Collider& c) { UpdateBounds(tf, c, bounds); });
+                }), frames);
+
+            LogResult("pooled DestroyAllEntities", MeasureMs([&] { coordinator.DestroyAllEntities(); }));
+        }
+
+        // archetype chunks
+        {
+            BenchmarkScene scene(StorageMode::SM_Archetype);
+            Coordinator& coordinator = scene.coordinator;
+
+            LogResult("archetype spawn", MeasureMs([&] { SpawnStressTest(coordinator, entityCount); }));
+
+            LogResult("archetype ForEach<Transform, RigidBody>", MeasureMs([&]
+                {
+                    for (int f = 0; f < frames; ++f)
+                        coordinator.ForEach<Transform, RigidBody>([dt](Entity, Transform& tf, RigidBody& rb) { IntegrateBody(tf, rb, dt); });
+                }), frames);
+
+            std::array<BoundingBox, MAX_COLLIDER_SHAPES> bounds{};
+
+            LogResult("archetype ForEach<Transform, Collider> bounds", MeasureMs([&]
+                {
+                    for (int f = 0; f < frames; ++f)
+                        coordinator.ForEach<Transform, Collider>([&bounds](Entity, Transform& tf, Collider& c) { UpdateBounds(tf, c, bounds); });
+                }), frames);
+
+            LogResult("archetype DestroyAllEntities", MeasureMs([&] { coordinator.DestroyAllEntities(); }));
+        }
+    }
+
+    void ECSBenchmark::RunTypeLookupBenchmark(size_t calls)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Type lookup : typeid name map vs family id, calls = " + std::to_string(calls));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+
+        // rebuild the lookup the ComponentManager used to do, so the old path can still be timed
+        std::unordered_map<std::string, BaseComponentArray*> nameToArray;
+        nameToArray.insert({ std::string(typeid(Transform).name()), &coordinator.GetComponentArray<Transform>() });
+        nameToArray.insert({ std::string(typeid(RigidBody).name()), &coordinator.GetComponentArray<RigidBody>() });
+        nameToArray.insert({ std::string(typeid(Collider).name()), &coordinator.GetComponentArray<Collider>() });
+        nameToArray.insert({ std::string(typeid(Sprite).name()), &coordinator.GetComponentArray<Sprite>() });
+        nameToArray.insert({ std::string(typeid(Camera).name()), &coordinator.GetComponentArray<Camera>() });
+        nameToArray.insert({ std::string(typeid(Player).name()), &coordinator.GetComponentArray<Player>() });
+        nameToArray.insert({ std::string(typeid(Enemy).name()), &coordinator.GetComponentArray<Enemy>() });
+
+        // summing the addresses keeps the compiler from dropping the lookups
+        volatile uintptr_t sink = 0;
+
+        double before = MeasureMs([&]
+            {
+                for (size_t i = 0; i < calls; ++i)
+                {
+                    std::string type_name = std::string(typeid(Collider).name());
+                    sink = sink + reinterpret_cast<uintptr_t>(static_cast<ComponentArray<Collider>*>(nameToArray[type_name]));
+                }
+            });
+
+        double after = MeasureMs([&]
+            {
+                for (size_t i = 0; i < calls; ++i)
+                {
+                    sink = sink + reinterpret_cast<uintptr_t>(&coordinator.GetComponentArray<Collider>());
+                }
+            });
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2)
+            << "[ECS Benchmark] GetComponentArray<T> per call : typeid name map " << (before * 1000000.0 / static_cast<double>(calls))
+            << " ns, family id " << (after * 1000000.0 / static_cast<double>(calls)) << " ns";
+        Debugger::Log(WarningLevel::eInfo, ss.str());
+    }
+
+    void ECSBenchmark::RunViewBenchmark(size_t entityCount, int frames)
+    {
+        const float dt = 1.f / 60.f;
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] View : aEntities + GetData vs Coordinator::View, entities = " + std::to_string(entityCount));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+
+        auto physics = coordinator.RegisterSystem<PhysicsSystem>();
+        {
+            Signature sign;
+            sign.set(coordinator.GetComponentType<RigidBody>());
+            sign.set(coordinator.GetComponentType<Transform>());
+            coordinator.SetSystemSignature<PhysicsSystem>(sign);
+        }
+        physics->Init(&coordinator);
+
+        SpawnStressTest(coordinator, entityCount);
+
+        // a single player, the view over <Transform, Player> should only walk the Player pool
+        Entity player = coordinator.CreateEntity();
+        coordinator.AddComponent(player, Transform{ .position = Vec2(0, 0), .rotation = Vec2(0, 0), .scale = Vec2(1.f, 1.f) });
+        coordinator.AddComponent(player, RigidBody{ .velocity = Vec2(0.0f, 0.0f), .acceleration = Vec2(0.0f, 0.0f), .accel_strength = 200, .fric_coeff = 100 });
+        coordinator.AddComponent(player, Player{});
+
+        auto& tfArray = coordinator.GetComponentArray<Transform>();
+        auto& rbArray = coordinator.GetComponentArray<RigidBody>();
+
+        LogResult("aEntities + GetData<Transform, RigidBody>", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto const& entity : physics->aEntities)
+                    {
+                        MoveBody(tfArray.GetData(entity), rbArray.GetData(entity), dt);
+                    }
+                }
+            }), frames);
+
+        LogResult("View<Transform, RigidBody> range-for", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto [entity, tf, rb] : coordinator.View<Transform, RigidBody>())
+                    {
+                        MoveBody(tf, rb, dt);
+                    }
+                }
+            }), frames);
+
+        LogResult("View<Transform, RigidBody>::Each", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    coordinator.View<Transform, RigidBody>().Each([dt](Entity, Transform& tf, RigidBody& rb) { MoveBody(tf, rb, dt); });
+                }
+            }), frames);
+
+        size_t matched = 0;
+        LogResult("View<Transform, RigidBody>(Exclude<Enemy>)", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto [entity, tf, rb] : coordinator.View<Transform, RigidBody>(Exclude<Enemy>{}))
+                    {
+                        MoveBody(tf, rb, dt);
+                        ++matched;
+                    }
+                }
+            }), frames);
+
+        LogResult("aEntities scan for Player", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto const& entity : physics->aEntities)
+                    {
+                        if (!coordinator.HasComponent<Player>(entity)) continue;
+                        MoveBody(tfArray.GetData(entity), rbArray.GetData(entity), dt);
+                    }
+                }
+            }), frames);
+
+        LogResult("View<Transform, RigidBody, Player> (Player pool drives)", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto [entity, tf, rb, p] : coordinator.View<Transform, RigidBody, Player>())
+                    {
+                        MoveBody(tf, rb, dt);
+                    }
+                }
+            }), frames);
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Exclude<Enemy> matched " + std::to_string(matched / static_cast<size_t>(frames)) + " entities per frame");
+    }
+
+    void ECSBenchmark::RunSystemMembershipBenchmark(size_t entityCount)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] System membership : 5 systems, entities = " + std::to_string(entityCount));
+
+        // full spawn / destroy through the coordinator with the scene systems registered
+        std::vector<Entity> entities;
+        std::vector<Signature> signatures;
+        std::vector<Signature> systemSignatures;
+        {
+            BenchmarkScene scene;
+            Coordinator& coordinator = scene.coordinator;
+
+            systemSignatures = MakeSceneSystemSignatures(coordinator);
+            RegisterSceneSystems(coordinator, systemSignatures);
+
+            LogResult("coordinator spawn (StressTest)", MeasureMs([&] { SpawnStressTest(coordinator, entityCount); }));
+
+            // the final signature of every entity, replayed below without the coordinator around it
+            // a fresh coordinator hands out ids 0..n-1
+            for (Entity entity = 0; entity < static_cast<Entity>(entityCount); ++entity)
+            {
+                if (!coordinator.HasActiveEntity(entity)) continue;
+
+                entities.push_back(entity);
+                signatures.push_back(coordinator.GetEntitySignature(entity));
+            }
+
+            LogResult("coordinator DestroyAllEntities", MeasureMs([&] { coordinator.DestroyAllEntities(); }));
+
+            // scene reload path, the pools and system lists are reset without visiting the entities
+            SpawnStressTest(coordinator, entityCount);
+            LogResult("coordinator ClearWorld", MeasureMs([&] { coordinator.ClearWorld(); }));
+        }
+
+        // the previous implementation, std::find on insert and a linear scan on removal
+        {
+            std::vector<std::vector<Entity>> systems(systemSignatures.size());
+
+            double ms = MeasureMs([&]
+                {
+                    for (size_t e = 0; e < entities.size(); ++e)
+                    {
+                        for (size_t s = 0; s < systems.size(); ++s)
+                        {
+                            if ((signatures[e] & systemSignatures[s]) != systemSignatures[s]) continue;
+
+                            auto& list = systems[s];
+                            if (std::find(list.begin(), list.end(), entities[e]) == list.end())
+                            {
+                                list.emplace_back(entities[e]);
+                            }
+                        }
+                    }
+
+                    for (Entity entity : entities)
+                    {
+                        for (auto& list : systems)
+                        {
+                            for (size_t i = 0; i < list.size(); ++i)
+                            {
+                                if (list[i] == entity)
+                                {
+                                    list[i] = list.back();
+                                    list.pop_back();
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                });
+
+            LogResult("linear scan membership add + remove", ms);
+        }
+
+        // slot index, one entity at a time
+        {
+            Uma_ECS::SystemManager systemManager;
+            RegisterSceneSystems(systemManager, systemSignatures);
+
+            double ms = MeasureMs([&]
+                {
+                    for (size_t e = 0; e < entities.size(); ++e)
+                    {
+                        systemManager.EntitySignatureChanged(entities[e], signatures[e]);
+                    }
+
+                    for (Entity entity : entities)
+                    {
+                        systemManager.EntityDestroyed(entity);
+                    }
+                });
+
+            LogResult("slot index membership add + remove", ms);
+        }
+
+        // slot index, whole batch in one pass per system
+        {
+            Uma_ECS::SystemManager systemManager;
+            RegisterSceneSystems(systemManager, systemSignatures);
+
+            double ms = MeasureMs([&]
+                {
+                    systemManager.EntitiesSignatureChanged(entities, signatures);
+                    systemManager.EntitiesDestroyed(entities);
+                });
+
+            LogResult("slot index bulk membership add + remove", ms);
+        }
+    }
+
+    void ECSBenchmark::RunSpawnBenchmark(size_t entityCount)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Spawn : 5 systems, enemies = " + std::to_string(entityCount));
+
+        // fresh coordinator with the scene systems for every run, only the spawn itself is timed
+        auto spawn = [entityCount](const std::string& name, StorageMode mode, auto&& func)
+            {
+                BenchmarkScene scene(mode);
+                Coordinator& coordinator = scene.coordinator;
+                RegisterSceneSystems(coordinator, MakeSceneSystemSignatures(coordinator));
+
+                LogResult(name, MeasureMs([&] { func(coordinator); }));
+
+                if (static_cast<size_t>(coordinator.GetEntityCount()) != entityCount)
+                {
+                    Debugger::Log(WarningLevel::eWarning, "[ECS Benchmark] " + name + " spawned " + std::to_string(coordinator.GetEntityCount()) + " entities");
+                }
+            };
+
+        // every enemy built from scratch, 5 AddComponent calls each
+        spawn("CreateEntity + AddComponent per enemy", StorageMode::SM_Pooled, [entityCount](Coordinator& coordinator)
+            {
+                for (size_t i = 0; i < entityCount; ++i)
+                {
+                    CreateEnemyTemplate(coordinator);
+                }
+            });
+
+        // the previous StressTest, one DuplicateEntity per enemy
+        spawn("DuplicateEntity per enemy", StorageMode::SM_Pooled, [entityCount](Coordinator& coordinator)
+            {
+                Entity enemy = CreateEnemyTemplate(coordinator);
+
+                for (size_t i = 1; i < entityCount; ++i)
+                {
+                    coordinator.DuplicateEntity(enemy);
+                }
+            });
+
+        spawn("Instantiate batch", StorageMode::SM_Pooled, [entityCount](Coordinator& coordinator)
+            {
+                Entity enemy = CreateEnemyTemplate(coordinator);
+                coordinator.Instantiate(enemy, entityCount - 1);
+            });
+
+        // default components then filled through a view, for spawners that don't have a template entity
+        spawn("CreateEntities batch + View fill", StorageMode::SM_Pooled, [entityCount](Coordinator& coordinator)
+            {
+                Signature signature;
+                signature.set(coordinator.GetComponentType<Transform>());
+                signature.set(coordinator.GetComponentType<RigidBody>());
+                signature.set(coordinator.GetComponentType<Collider>());
+                signature.set(coordinator.GetComponentType<Sprite>());
+                signature.set(coordinator.GetComponentType<Enemy>());
+
+                coordinator.CreateEntities(entityCount, signature);
+
+                for (auto [entity, tf, rb, sr] : coordinator.View<Transform, RigidBody, Sprite>())
+                {
+                    tf.scale = Vec2(1.f, 1.f);
+                    rb.accel_strength = 200;
+                    rb.fric_coeff = 100;
+                    sr.textureName = "pink_enemy";
+                }
+            });
+
+        spawn("DuplicateEntity per enemy (archetype storage)", StorageMode::SM_Archetype, [entityCount](Coordinator& coordinator)
+            {
+                Entity enemy = CreateEnemyTemplate(coordinator);
+
+                for (size_t i = 1; i < entityCount; ++i)
+                {
+                    coordinator.DuplicateEntity(enemy);
+                }
+            });
+
+        spawn("Instantiate batch (archetype storage)", StorageMode::SM_Archetype, [entityCount](Coordinator& coordinator)
+            {
+                Entity enemy = CreateEnemyTemplate(coordinator);
+                coordinator.Instantiate(enemy, entityCount - 1);
+            });
+    }
+
+    bool ECSBenchmark::CheckComponentMoves(size_t entityCount)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Check] Component moves : entities = " + std::to_string(entityCount));
+
+        bool passed = true;
+
+        for (StorageMode mode : { StorageMode::SM_Pooled, StorageMode::SM_Archetype })
+        {
+            std::string suffix = mode == StorageMode::SM_Pooled ? " (pooled)" : " (archetype)";
+
+            BenchmarkScene scene(mode);
+            Coordinator& coordinator = scene.coordinator;
+            coordinator.RegisterComponent<AllocProbe>();
+
+            std::vector<Entity> entities = coordinator.CreateEntities(entityCount);
+
+            // every probe owns one heap block, built before the checked parts
+            auto makeProbes = [entityCount]()
+                {
+                    std::vector<AllocProbe> probes(entityCount);
+                    for (AllocProbe& probe : probes) probe.aData.assign(16, 1);
+                    return probes;
+                };
+
+            auto removeAll = [&]()
+                {
+                    for (Entity entity : entities) coordinator.RemoveComponent<AllocProbe>(entity);
+                };
+
+            // the move paths hand the probe's block over, a single allocation means something copied it
+            auto expectNoAllocations = [&passed](const std::string& name, auto&& func)
+                {
+                    if (LogAllocations(name, func) == 0) return;
+
+                    Debugger::Log(WarningLevel::eError, "[ECS Check] " + name + " allocated, the component was copied instead of moved.");
+                    passed = false;
+                };
+
+            std::vector<AllocProbe> probes = makeProbes();
+
+            // one copy per entity is the cost a const T& add can't avoid
+            LogAllocations("AddComponent copy" + suffix, [&]
+                {
+                    for (size_t i = 0; i < entityCount; ++i) coordinator.AddComponent(entities[i], probes[i]);
+                });
+
+            // swap and pop moves the last component into every hole
+            expectNoAllocations("RemoveComponent" + suffix, removeAll);
+
+            expectNoAllocations("AddComponent move" + suffix, [&]
+                {
+                    for (size_t i = 0; i < entityCount; ++i) coordinator.AddComponent(entities[i], std::move(probes[i]));
+                });
+
+            removeAll();
+            probes = makeProbes();
+
+            expectNoAllocations("EmplaceComponent" + suffix, [&]
+                {
+                    for (size_t i = 0; i < entityCount; ++i) coordinator.EmplaceComponent<AllocProbe>(entities[i], std::move(probes[i]));
+                });
+
+            removeAll();
+            probes = makeProbes();
+
+            expectNoAllocations("EntityCommandBuffer AddComponent + Flush" + suffix, [&]
+                {
+                    EntityCommandBuffer& commands = coordinator.GetCommandBuffer();
+                    for (size_t i = 0; i < entityCount; ++i) commands.AddComponent(entities[i], std::move(probes[i]));
+                    coordinator.FlushCommands();
+                });
+
+            // the copy owns its own block, one allocation per duplicate and no temporary copy
+            LogAllocations("DuplicateEntity" + suffix, [&]
+                {
+                    for (size_t i = 0; i < entityCount; ++i) coordinator.DuplicateEntity(entities[i]);
+                });
+        }
+
+        assert(passed && "Error : A component move path allocated.");
+        return passed;
+    }
+
+    void ECSBenchmark::RunHotColdBenchmark(size_t entityCount, int frames)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Hot / cold split : Collider and Sprite, entities = " + std::to_string(entityCount));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+        coordinator.RegisterComponent<LegacyCollider>();
+        coordinator.RegisterComponent<LegacySprite>();
+
+        SpawnStressTest(coordinator, entityCount);
+
+        // the same scene in the old layout, added entity by entity so the shape / bounds vectors are spread like a spawned scene
+        std::vector<Entity> entities;
+        for (auto [entity, c, sr] : coordinator.View<Collider, Sprite>()) entities.push_back(entity);
+
+        for (Entity entity : entities)
+        {
+            const Collider& c = coordinator.GetComponentArray<Collider>().GetData(entity);
+            const Sprite& sr = coordinator.GetComponentArray<Sprite>().GetData(entity);
+
+            LegacyCollider legacy{ c.shapes, c.defaultLayer, c.defaultMask, c.showBBox, std::vector<BoundingBox>(c.shapes.size()) };
+            coordinator.AddComponent(entity, std::move(legacy));
+            coordinator.AddComponent(entity, LegacySprite{ sr.textureName, sr.renderLayer, sr.flipX, sr.flipY, sr.UseNativeSize, nullptr });
+        }
+
+        auto& cArray = coordinator.GetComponentArray<Collider>();
+        auto& sArray = coordinator.GetComponentArray<Sprite>();
+        auto& legacyColliders = coordinator.GetComponentArray<LegacyCollider>();
+
+        // footprint of one entity's data a pass has to pull in, the legacy collider is three separate blocks
+        {
+            const LegacyCollider& legacy = legacyColliders.GetComponentAt(0);
+            size_t legacyBytes = sizeof(LegacyCollider) + legacy.shapes.capacity() * sizeof(ColliderShape) + legacy.bounds.capacity() * sizeof(BoundingBox);
+
+            std::stringstream ss;
+            ss << "[ECS Benchmark] Collider bytes per entity : legacy " << legacyBytes << " in 3 blocks, ColliderHot " << sizeof(ColliderHot)
+                << " packed | Sprite : legacy " << sizeof(LegacySprite) << ", SpriteHot " << sizeof(SpriteHot);
+            Debugger::Log(WarningLevel::eInfo, ss.str());
+        }
+
+        // bounds update, reads the shapes and writes the bounds of every collider
+        LogResult("legacy Collider bounds (shapes + bounds vectors)", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto [entity, c, tf] : coordinator.View<LegacyCollider, Transform>())
+                    {
+                        for (size_t i = 0; i < c.shapes.size(); ++i)
+                        {
+                            const auto& shape = c.shapes[i];
+                            if (!shape.isActive) continue;
+
+                            Vec2 halfSize = Vec2{ shape.size.x * tf.scale.x, shape.size.y * tf.scale.y } * 0.5f;
+                            Vec2 worldPosition = tf.position + Vec2{ shape.offset.x * tf.scale.x, shape.offset.y * tf.scale.y };
+                            c.bounds[i].min = worldPosition - halfSize;
+                            c.bounds[i].max = worldPosition + halfSize;
+                        }
+                    }
+                }
+            }), frames);
+
+        LogResult("ColliderHot bounds", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (auto [entity, c, tf] : coordinator.View<Collider, Transform>()) UpdateBounds(tf, cArray.GetHot(c));
+                }
+            }), frames);
+
+        // broad / narrow phase filter, every shape's bounds, layer, mask and purpose in pool order
+        volatile float sink = 0.f;
+
+        LogResult("legacy Collider shape scan", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    float sum = 0.f;
+                    for (size_t n = 0; n < legacyColliders.Size(); ++n)
+                    {
+                        const LegacyCollider& c = legacyColliders.GetComponentAt(n);
+                        for (size_t i = 0; i < c.shapes.size(); ++i)
+                        {
+                            const ColliderShape& shape = c.shapes[i];
+                            LayerMask layer = shape.layer != CL_NONE ? shape.layer : c.defaultLayer;
+                            LayerMask mask = shape.colliderMask != CL_NONE ? shape.colliderMask : c.defaultMask;
+
+                            if (shape.isActive && (layer & mask) && shape.purpose != ColliderPurpose::Trigger) sum += c.bounds[i].min.x;
+                        }
+                    }
+                    sink = sink + sum;
+                }
+            }), frames);
+
+        LogResult("ColliderHot shape scan", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    float sum = 0.f;
+                    for (const ColliderHot& c : cArray.GetHotArray())
+                    {
+                        for (size_t i = 0; i < c.count && i < INLINE_COLLIDER_SHAPES; ++i)
+                        {
+                            const ColliderShapeHot& shape = c.shapes[i];
+                            if (c.IsActive(i) && (shape.layer & shape.mask) && shape.purpose != ColliderPurpose::Trigger) sum += shape.bounds.min.x;
+                        }
+                    }
+                    sink = sink + sum;
+                }
+            }), frames);
+
+        // draw list gather of RenderingSystem, texture, layer and flags next to the transform
+        LogResult("legacy Sprite draw list", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    float sum = 0.f;
+                    for (auto [entity, sr, tf] : coordinator.View<LegacySprite, Transform>())
+                    {
+                        if (!sr.texture && sr.renderLayer != RL_UI) sum += tf.position.x * (sr.flipX ? -1.f : 1.f);
+                    }
+                    sink = sink + sum;
+                }
+            }), frames);
+
+        LogResult("SpriteHot draw list", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    float sum = 0.f;
+                    for (auto [entity, sr, tf] : coordinator.View<Sprite, Transform>())
+                    {
+                        const SpriteHot& hot = sArray.GetHot(sr);
+                        if (!hot.texture && hot.renderLayer != RL_UI) sum += tf.position.x * (hot.flipX ? -1.f : 1.f);
+                    }
+                    sink = sink + sum;
+                }
+            }), frames);
+    }
+
+    void ECSBenchmark::RunDefragmentBenchmark(size_t entityCount, int frames)
+    {
+        const float dt = 1.f / 60.f;
+        const int churnRounds = 5;
+        const double budgetMs = 0.25;
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Defragment : churn then iterate, entities = " + std::to_string(entityCount));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+
+        auto physics = coordinator.RegisterSystem<BenchPhysicsSystem>();
+        {
+            Signature sign;
+            sign.set(coordinator.GetComponentType<RigidBody>());
+            sign.set(coordinator.GetComponentType<Transform>());
+            sign.set(coordinator.GetComponentType<Collider>());
+            coordinator.SetSystemSignature<BenchPhysicsSystem>(sign);
+        }
+
+        SpawnStressTest(coordinator, entityCount);
+
+        auto& tfArray = coordinator.GetComponentArray<Transform>();
+        auto& rbArray = coordinator.GetComponentArray<RigidBody>();
+        auto& cArray = coordinator.GetComponentArray<Collider>();
+
+        // PhysicsSystem / CollisionSystem style pass, the system list drives GetData on three pools
+        auto pass = [&]()
+            {
+                for (int f = 0; f < frames; ++f)
+                {
+                    for (Entity entity : physics->aEntities)
+                    {
+                        Transform& tf = tfArray.GetData(entity);
+                        MoveBody(tf, rbArray.GetData(entity), dt);
+                        UpdateBounds(tf, cArray.GetHot(entity));
+                    }
+                }
+            };
+
+        LogResult("fresh scene, aEntities + GetData", MeasureMs(pass), frames);
+
+        // DestroyRandomEntity / respawn rounds, the recycled ids come back in destruction order
+        std::mt19937 generator(11);
+        Entity enemy = CreateEnemyTemplate(coordinator);
+
+        for (int round = 0; round < churnRounds; ++round)
+        {
+            std::vector<Entity> victims = physics->aEntities;
+            std::shuffle(victims.begin(), victims.end(), generator);
+            victims.erase(std::remove(victims.begin(), victims.end(), enemy), victims.end());
+            victims.resize(victims.size() / 2);
+
+            // a hundred per frame, the events are processed at the end of every frame like the engine does
+            for (size_t i = 0; i < victims.size(); ++i)
+            {
+                coordinator.DestroyEntity(victims[i]);
+                if (i % 100 == 99) scene.eventSystem.ProcessEvents();
+            }
+            scene.eventSystem.ProcessEvents();
+
+            coordinator.Instantiate(enemy, victims.size());
+        }
+
+        LogResult("after churn, aEntities + GetData", MeasureMs(pass), frames);
+
+        // budgeted like EditorScene, one slice per frame until everything is in order
+        int defragmentFrames = 0;
+        double defragmentMs = MeasureMs([&]
+            {
+                while (!coordinator.Defragment(budgetMs)) ++defragmentFrames;
+            });
+        ++defragmentFrames;
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(4) << "[ECS Benchmark] Defragment : " << defragmentMs << " ms over " << defragmentFrames
+            << " frames of " << budgetMs << " ms";
+        Debugger::Log(WarningLevel::eInfo, ss.str());
+
+        LogResult("after defragment, aEntities + GetData", MeasureMs(pass), frames);
+
+        // nothing left to do, the per frame call is a few flag checks
+        LogResult("Defragment on an ordered world", MeasureMs([&]
+            {
+                for (int f = 0; f < frames; ++f) coordinator.Defragment(budgetMs);
+            }), frames);
+    }
+
+    void ECSBenchmark::RunPrefabBenchmark(size_t instanceCount)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Prefab instantiation : instances = " + std::to_string(instanceCount));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+
+        // the enemy prefab as GameSerializer::savePrefab writes it, kept in memory so no variant pays for the disk
+        std::string prefabJson;
+        {
+            Entity enemy = CreateEnemyTemplate(coordinator);
+
+            rapidjson::Document doc;
+            doc.SetObject();
+            rapidjson::Value section(rapidjson::kObjectType);
+            coordinator.SerializePrefab(enemy, section, doc.GetAllocator());
+            doc.AddMember("Prefab", section, doc.GetAllocator());
+
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            doc.Accept(writer);
+            prefabJson = buffer.GetString();
+
+            coordinator.DestroyEntity(enemy);
+        }
+
+        auto position = [](size_t i) { return Vec2(static_cast<float>(i % 100), static_cast<float>(i / 100)); };
+
+        // every spawn sends its own created event, processed like once a frame so the queue stays short
+        auto reset = [&]()
+            {
+                scene.eventSystem.ProcessEvents();
+                coordinator.ClearWorld();
+                scene.eventSystem.ProcessEvents();
+            };
+        reset();
+
+        LogResult("parse JSON + DeserializePrefab per spawn", MeasureMs([&]
+            {
+                for (size_t i = 0; i < instanceCount; ++i)
+                {
+                    rapidjson::Document doc;
+                    doc.Parse(prefabJson.c_str());
+                    coordinator.DeserializePrefab(doc["Prefab"]);
+
+                    if (i % 100 == 99) scene.eventSystem.ProcessEvents();
+                }
+            }));
+        reset();
+
+        Prefab enemy;
+        LogResult("convert the prefab once", MeasureMs([&]
+            {
+                rapidjson::Document doc;
+                doc.Parse(prefabJson.c_str());
+                enemy = coordinator.MakePrefab(doc["Prefab"]);
+            }));
+
+        LogResult("cached template, one Instantiate per spawn", MeasureMs([&]
+            {
+                for (size_t i = 0; i < instanceCount; ++i)
+                {
+                    coordinator.Instantiate(enemy, 1, [&](size_t, Entity entity)
+                        {
+                            coordinator.GetComponent<Transform>(entity).position = position(i);
+                        });
+
+                    if (i % 100 == 99) scene.eventSystem.ProcessEvents();
+                }
+            }));
+        reset();
+
+        std::vector<Entity> instances;
+        LogResult("cached template, one batched Instantiate", MeasureMs([&]
+            {
+                instances = coordinator.Instantiate(enemy, instanceCount, [&](size_t i, Entity entity)
+                    {
+                        coordinator.GetComponent<Transform>(entity).position = position(i);
+                    });
+            }));
+
+        if (instances.size() != instanceCount || coordinator.ReadComponent<Transform>(instances.back()).position.x != position(instanceCount - 1).x)
+        {
+            Debugger::Log(WarningLevel::eError, "[ECS Benchmark] Prefab instantiation : instances don't match the template.");
+        }
+
+        reset();
+    }
+
+    void ECSBenchmark::RunSpatialHashBenchmark(size_t entityCount, int frames)
+    {
+        const float dt = 1.f / 60.f;
+        const float cellSize = SpatialHashGrid::DEFAULT_CELL_SIZE;
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Collision broadphase grid : moving enemies = " + std::to_string(entityCount));
+
+        BenchmarkScene scene;
+        Coordinator& coordinator = scene.coordinator;
+
+        SpawnStressTest(coordinator, entityCount);
+        scene.eventSystem.ProcessEvents();
+
+        auto& cArray = coordinator.GetComponentArray<Collider>();
+        cArray.SyncHot();
+
+        // PhysicsSystem + UpdateBoundingBoxes, the same for both grids and left out of the timings
+        auto step = [&]()
+            {
+                for (auto [entity, c, tf, rb] : coordinator.View<Collider, Transform, RigidBody>())
+                {
+                    MoveBody(tf, rb, dt);
+                    UpdateBounds(tf, cArray.GetHot(c));
+                }
+            };
+
+        // candidate pairs walked by UpdateCollision, both grids must hand out the same count
+        auto countPairs = [](const std::vector<Entity>& entities)
+            {
+                return entities.size() * (entities.size() - 1) / 2;
+            };
+
+        double legacyMs = 0.0;
+        double persistentMs = 0.0;
+        size_t legacyPairs = 0;
+        size_t persistentPairs = 0;
+        size_t reinserted = 0;
+
+        SpatialHashGrid grid(cellSize);
+
+        for (int f = 0; f < frames; ++f)
+        {
+            step();
+
+            legacyMs += MeasureMs([&]
+                {
+                    LegacyGrid legacy;
+
+                    for (auto [entity, c, tf, rb] : coordinator.View<Collider, Transform, RigidBody>())
+                    {
+                        const ColliderHot& hot = cArray.GetHot(c);
+                        if (hot.count > 0 && hot.IsActive(0)) InsertIntoLegacyGrid(legacy, entity, hot.shapes[0].bounds, cellSize);
+                    }
+
+                    for (auto const& [cell, entities] : legacy)
+                    {
+                        if (entities.size() >= 2) legacyPairs += countPairs(entities);
+                    }
+                });
+
+            persistentMs += MeasureMs([&]
+                {
+                    grid.BeginFrame();
+
+                    for (auto [entity, c, tf, rb] : coordinator.View<Collider, Transform, RigidBody>())
+                    {
+                        const ColliderHot& hot = cArray.GetHot(c);
+                        if (hot.count > 0 && hot.IsActive(0) && grid.Update(entity, hot.shapes[0].bounds)) ++reinserted;
+                    }
+
+                    grid.Sweep();
+
+                    grid.ForEachCell([&](const Cell&, const std::vector<Entity>& entities)
+                        {
+                            persistentPairs += countPairs(entities);
+                        }, 2);
+                });
+        }
+
+        LogResult("unordered_map grid rebuilt every frame", legacyMs, frames);
+        LogResult("persistent open-addressed grid", persistentMs, frames);
+
+        std::stringstream ss;
+        ss << "[ECS Benchmark] Collision broadphase grid : re-inserted " << reinserted << " colliders over " << frames
+            << " frames (the first one inserts all " << entityCount << "), " << grid.CellCount() << " cells";
+        Debugger::Log(WarningLevel::eInfo, ss.str());
+
+        if (legacyPairs != persistentPairs)
+        {
+            Debugger::Log(WarningLevel::eError, "[ECS Benchmark] Collision broadphase grid : the grids found different candidate pairs.");
+        }
+    }
+
+    void ECSBenchmark::RunSweepAndPruneBenchmark(size_t entityCount, int frames)
+    {
+        const float dt = 1.f / 60.f;
+
+        for (bool clustered : { false, true })
+        {
+            Debugger::Log(WarningLevel::eInfo, std::string("[ECS Benchmark] Grid vs sweep and prune : ")
+                + (clustered ? "clustered" : "spread") + " scene, moving enemies = " + std::to_string(entityCount));
+
+            BenchmarkScene scene;
+            Coordinator& coordinator = scene.coordinator;
+
+            SpawnStressTest(coordinator, entityCount);
+            scene.eventSystem.ProcessEvents();
+
+            if (clustered)
+            {
+                // a few crowds, the kind of scene a grid cell fills up in
+                std::default_random_engine generator;
+                std::uniform_real_distribution<float> randCenterX(-1920.f, 1920.f);
+                std::uniform_real_distribution<float> randCenterY(-1080.f, 1080.f);
+                std::normal_distribution<float> randOffset(0.f, 60.f);
+
+                std::vector<Vec2> centers;
+                for (int i = 0; i < 16; ++i) centers.push_back(Vec2(randCenterX(generator), randCenterY(generator)));
+
+                size_t i = 0;
+                for (auto [entity, tf] : coordinator.View<Transform>())
+                {
+                    const Vec2& center = centers[i++ % centers.size()];
+                    tf.position = Vec2(center.x + randOffset(generator), center.y + randOffset(generator));
+                }
+            }
+
+            auto& cArray = coordinator.GetComponentArray<Collider>();
+            cArray.SyncHot();
+
+            // the bounds are moved once per frame and the same frame is handed to both broadphases
+            std::vector<std::pair<Entity, BoundingBox>> frameBounds;
+            auto step = [&]()
+                {
+                    frameBounds.clear();
+                    for (auto [entity, c, tf, rb] : coordinator.View<Collider, Transform, RigidBody>())
+                    {
+                        MoveBody(tf, rb, dt);
+                        UpdateBounds(tf, cArray.GetHot(c));
+                        frameBounds.emplace_back(entity, cArray.GetHot(c).shapes[0].bounds);
+                    }
+                };
+
+            SpatialHashGrid grid;
+            SweepAndPrune sap;
+            std::vector<PairKey> gridPairs, sapPairs, scratch;
+
+            double gridMs = 0.0, sapMs = 0.0, gridFirstMs = 0.0, sapFirstMs = 0.0;
+            size_t gridCandidates = 0, gridOverlapping = 0, sapCandidates = 0, sapTested = 0;
+            bool samePairs = true;
+
+            for (int f = 0; f <= frames; ++f)
+            {
+                step();
+
+                double ms = MeasureMs([&]
+                    {
+                        grid.BeginFrame();
+                        for (auto& [entity, box] : frameBounds) grid.Update(entity, box);
+                        grid.Sweep();
+
+                        gridPairs.clear();
+                        grid.GatherPairs(gridPairs);
+                        SortPairs(gridPairs, scratch);
+                    });
+                (f == 0 ? gridFirstMs : gridMs) += ms;
+
+                ms = MeasureMs([&]
+                    {
+                        sap.BeginFrame();
+                        for (auto& [entity, box] : frameBounds) sap.Update(entity, box);
+                        sap.Sweep();
+
+                        sapPairs.clear();
+                        sapTested += sap.GatherPairs(sapPairs);
+                        SortPairs(sapPairs, scratch);
+                    });
+                (f == 0 ? sapFirstMs : sapMs) += ms;
+
+                // sweep and prune only keeps overlapping bounds, the grid's pairs left after the same test must match
+                gridCandidates += gridPairs.size();
+                sapCandidates += sapPairs.size();
+
+                std::vector<PairKey> overlapping;
+                for (PairKey pair : gridPairs)
+                {
+                    const BoundingBox& a = cArray.GetHot(PairFirst(pair)).shapes[0].bounds;
+                    const BoundingBox& b = cArray.GetHot(PairSecond(pair)).shapes[0].bounds;
+                    if (!(a.max.x < b.min.x || a.min.x > b.max.x || a.max.y < b.min.y || a.min.y > b.max.y)) overlapping.push_back(pair);
+                }
+                gridOverlapping += overlapping.size();
+                samePairs = samePairs && overlapping == sapPairs;
+            }
+
+            LogResult("grid, first frame (every collider inserted)", gridFirstMs);
+            LogResult("sweep and prune, first frame (sort + sweep)", sapFirstMs);
+            LogResult("grid, update + sorted pairs", gridMs, frames);
+            LogResult("sweep and prune, update + sorted pairs", sapMs, frames);
+
+            std::stringstream ss;
+            ss << "[ECS Benchmark] Grid vs sweep and prune : per frame grid " << (gridCandidates / (frames + 1))
+                << " candidate pairs (" << (gridOverlapping / (frames + 1)) << " overlapping), sweep and prune "
+                << (sapTested / (frames + 1)) << " pairs overlapping on X, " << (sapCandidates / (frames + 1)) << " candidate pairs";
+            Debugger::Log(WarningLevel::eInfo, ss.str());
+
+            if (!samePairs)
+            {
+                Debugger::Log(WarningLevel::eError, "[ECS Benchmark] Grid vs sweep and prune : the broadphases found different overlapping pairs.");
+            }
+        }
+    }
+
+    void ECSBenchmark::RunNarrowPhaseBenchmark(size_t shapePairCount, int iterations)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Narrow phase : shape pairs = " + std::to_string(shapePairCount)
+            + ", native path = " + SimdPathName(NATIVE_SIMD_PATH));
+
+        std::vector<std::pair<ShapeSide, ShapeSide>> shapePairs = MakeShapePairs(shapePairCount);
+
+        std::vector<uint32_t> expected;
+        ShapePairBatch batch;
+
+        LogResult("one pair at a time", MeasureMs([&] { for (int i = 0; i < iterations; ++i) TestOneByOne(shapePairs, expected); }), iterations);
+        LogResult("gather into the batch", MeasureMs([&] { for (int i = 0; i < iterations; ++i) GatherShapePairs(shapePairs, batch); }), iterations);
+
+        std::vector<uint32_t> hits;
+
+        for (SimdPath path : { SimdPath::SP_Scalar, SimdPath::SP_SSE2, SimdPath::SP_AVX2 })
+        {
+            if (!ShapePairBatch::IsAvailable(path)) continue;
+
+            double ms = MeasureMs([&]
+                {
+                    for (int i = 0; i < iterations; ++i)
+                    {
+                        hits.clear();
+                        batch.Test(hits, path);
+                    }
+                });
+            LogResult(std::string("batch test, ") + SimdPathName(path), ms, iterations);
+        }
+
+        Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Narrow phase : " + std::to_string(expected.size()) + " shape pairs collide");
+
+        const size_t entityCount = 10000;
+        const int frames = 30;
+
+        for (SimdPath path : { SimdPath::SP_Scalar, NATIVE_SIMD_PATH })
+        {
+            double ms = 0.0;
+            size_t contacts = 0;
+            RunCollisionScene(path, entityCount, frames, ms, contacts);
+
+            LogResult(std::string(SimdPathName(path)) + " path, CollisionSystem::Update", ms, frames);
+            Debugger::Log(WarningLevel::eInfo, "[ECS Benchmark] Narrow phase : " + std::to_string(contacts / frames) + " contacts per frame");
+        }
+    }
+
+    bool ECSBenchmark::CheckNarrowPhasePaths(size_t shapePairCount)
+    {
+        Debugger::Log(WarningLevel::eInfo, "[ECS Check] Narrow phase paths : shape pairs = " + std::to_string(shapePairCount)
+            + ", native path = " + SimdPathName(NATIVE_SIMD_PATH));
+
+        bool passed = true;
+
+        std::vector<std::pair<ShapeSide, ShapeSide>> shapePairs = MakeShapePairs(shapePairCount);
+
+        std::vector<uint32_t> expected;
+        TestOneByOne(shapePairs, expected);
+
+        ShapePairBatch batch;
+        GatherShapePairs(shapePairs, batch);
+
+        // every compiled path must find exactly the pairs the one pair at a time test finds, in the same order
+        for (SimdPath path : { SimdPath::SP_Scalar, SimdPath::SP_SSE2, SimdPath::SP_AVX2 })
+        {
+            if (!ShapePairBatch::IsAvailable(path)) continue;
+
+            std::vector<uint32_t> hits;
+            batch.Test(hits, path);
+
+            if (hits == expected) continue;
+
+            Debugger::Log(WarningLevel::eError, std::string("[ECS Check] Narrow phase paths : the ") + SimdPathName(path)
+                + " batch test disagrees with the one pair at a time test.");
+            passed = false;
+        }
+
+        // the whole CollisionSystem on the scalar and the native path must end in the same state
+        double ms = 0.0;
+        size_t contacts[2] = {};
+        double scalarChecksum = RunCollisionScene(SimdPath::SP_Scalar, 10000, 30, ms, contacts[0]);
+        double nativeChecksum = RunCollisionScene(NATIVE_SIMD_PATH, 10000, 30, ms, contacts[1]);
+
+        if (scalarChecksum != nativeChecksum || contacts[0] != contacts[1])
+        {
+            Debugger::Log(WarningLevel::eError, "[ECS Check] Narrow phase paths : the scalar and native CollisionSystem ended in different states.");
+            passed = false;
+        }
+
+        assert(passed && "Error : The narrow phase paths disagree.");
+        return passed;
+    }
+}
@@ -0,0 +1,133 @@
+/*!
+\file   Test_ECS_Benchmark.h
+\par    Project: GAM200
+\par    Course: CSD2401
+\par    Section A
+\par    Software Engineering Project 3
+
+\author Leong Wai Men (100%)
+\par    E-mail: waimen.leong@digipen.edu
+\par    DigiPen login: waimen.leong
+
+\brief
+Declares the headless ECS benchmarks used to compare storage and iteration strategies.
+
+Every benchmark builds its own Coordinator and EventSystem, so it never touches the scene that is currently loaded.
+Scenes mirror EditorScene::StressTest (10k enemies with Transform, RigidBody, Collider, Sprite and Enemy) and the
+results are written to the Debugger log. Triggered from the Entity Debug window through ECSBenchmarkRequestEvent.
+
+All content (C) 2025 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace Uma_Engine
+{
+    class ECSBenchmark
+    {
+    public:
+        /*!
+        * \brief Runs every ECS benchmark with the default stress test sizes
+        */
+        static void RunAll();
+
+        /*!
+        * \brief Compares per-type component pools against archetype chunk storage
+        * \param entityCount Number of enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunStorageBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Compares the per-call cost of the old typeid(T).name() string map lookup against family ids
+        * \param calls Number of lookups timed for each path
+        */
+        static void RunTypeLookupBenchmark(size_t calls = 1000000);
+
+        /*!
+        * \brief Compares iterating a system's aEntities with GetData against Coordinator::View
+        * \param entityCount Number of enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunViewBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Times system membership updates while spawning and destroying a StressTest scene,
+        *        destroying entity by entity against ClearWorld
+        * \param entityCount Number of enemies spawned in the scene
+        */
+        static void RunSystemMembershipBenchmark(size_t entityCount = 10000);
+
+        /*!
+        * \brief Times spawning a StressTest scene one entity at a time against CreateEntities / Instantiate batches
+        * \param entityCount Number of enemies spawned in the scene
+        */
+        static void RunSpawnBenchmark(size_t entityCount = 10000);
+
+        /*!
+        * \brief Checks that the add-move, emplace, remove and command buffer paths of a component owning heap memory
+        *        never allocate, logs the allocations of the copy and duplicate paths next to them
+        * \param entityCount Number of entities that get the component
+        * \return false (and asserts) when one of the move paths allocated
+        */
+        static bool CheckComponentMoves(size_t entityCount = 10000);
+
+        /*!
+        * \brief Compares the per frame Collider / Sprite passes over the old interleaved layout against the packed hot records
+        * \param entityCount Number of enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunHotColdBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Churns a StressTest scene (destroy / respawn rounds), then times a physics + bounds pass over the system's
+        * aEntities before and after Coordinator::Defragment, and how many budgeted frames the defragment takes
+        * \param entityCount Number of enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunDefragmentBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Spawns prefab instances by parsing the prefab JSON on every spawn (the LoadPrefabRequestEvent path),
+        * from the cached Prefab template one at a time and as one batch, with a per instance position override
+        * \param instanceCount Number of prefab instances spawned by every variant
+        */
+        static void RunPrefabBenchmark(size_t instanceCount = 10000);
+
+        /*!
+        * \brief Moves every enemy each frame and times the collision broadphase built as a fresh unordered_map grid
+        * every frame against the persistent SpatialHashGrid re-inserting only the colliders that crossed a cell boundary
+        * \param entityCount Number of moving enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunSpatialHashBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Compares the persistent grid against sweep and prune (the two CollisionSystem broadphase modes) on a
+        * StressTest scene spread over the screen and on the same enemies packed in a few clusters, broadphase update
+        * plus sorted candidate pairs, and checks both give the same overlapping pairs
+        * \param entityCount Number of moving enemies spawned in the scene
+        * \param frames Number of simulated frames that are timed
+        */
+        static void RunSweepAndPruneBenchmark(size_t entityCount = 10000, int frames = 100);
+
+        /*!
+        * \brief Times the narrow phase one shape pair at a time against the batched test on each compiled path
+        * (scalar, SSE2, AVX2), then the CollisionSystem on the scalar and the native path
+        * \param shapePairCount Number of random shape pairs tested
+        * \param iterations Number of times each test runs over the shape pairs
+        */
+        static void RunNarrowPhaseBenchmark(size_t shapePairCount = 100000, int iterations = 100);
+
+        /*!
+        * \brief Checks every compiled narrow phase path finds the same shape pairs as the one pair at a time test,
+        * and the CollisionSystem ends in the same state on the scalar and the native path
+        * \param shapePairCount Number of random shape pairs tested
+        * \return false (and asserts) when a path disagrees
+        */
+        static bool CheckNarrowPhasePaths(size_t shapePairCount = 100000);
+    };
+}